@@ -1,6 +1,8 @@
 #include "anchor-button.hpp"
 #include "rect-transform.hpp"
 #include <QPainter>
+#include <QPixmap>
+#include <QPixmapCache>
 #include <QStyleOption>
 
 AnchorButton::AnchorButton(AnchorH h, AnchorV v, QWidget *parent)
@@ -11,6 +13,14 @@ AnchorButton::AnchorButton(AnchorH h, AnchorV v, QWidget *parent)
     setAutoExclusive(true);
 }
 
+void AnchorButton::SetAnchor(AnchorH h, AnchorV v)
+{
+    if (h == hAlign && v == vAlign) return;
+    hAlign = h;
+    vAlign = v;
+    update();
+}
+
 AnchorPreset AnchorButton::GetPresetValues() const
 {
     return AnchorPreset::FromEnums(static_cast<int>(hAlign), static_cast<int>(vAlign));
@@ -18,21 +28,56 @@ AnchorPreset AnchorButton::GetPresetValues() const
 
 void AnchorButton::paintEvent(QPaintEvent *)
 {
+    GlyphState state = isChecked() ? GlyphState::Checked : underMouse() ? GlyphState::Hover : GlyphState::Normal;
     QPainter p(this);
+    p.drawPixmap(0, 0, Glyph(hAlign, vAlign, state, size(), devicePixelRatioF()));
+}
+
+QPixmap AnchorButton::Glyph(AnchorH h, AnchorV v, GlyphState state, const QSize &size, qreal dpr)
+{
+    // Rendered once per preset, state, size and device pixel ratio
+    QString key = QString("anchor-glyph/%1/%2/%3/%4x%5@%6")
+                      .arg((int)h)
+                      .arg((int)v)
+                      .arg((int)state)
+                      .arg(size.width())
+                      .arg(size.height())
+                      .arg(dpr);
+
+    QPixmap pixmap;
+    if (QPixmapCache::find(key, &pixmap)) return pixmap;
+
+    pixmap = QPixmap(size * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+    {
+        QPainter p(&pixmap);
+        DrawGlyph(p, QRect(QPoint(0, 0), size), h, v, state);
+    }
+    QPixmapCache::insert(key, pixmap);
+    return pixmap;
+}
+
+void AnchorButton::DrawGlyph(QPainter &p, const QRect &bounds, AnchorH hAlign, AnchorV vAlign, GlyphState state)
+{
     p.setRenderHint(QPainter::Antialiasing);
 
     // Background
-    if (isChecked()) {
-        p.fillRect(rect(), QColor(60, 60, 60)); // Highlight
-    } else if (underMouse()) {
-        p.fillRect(rect(), QColor(50, 50, 50));
-    } else {
-        p.fillRect(rect(), QColor(40, 40, 40));
+    switch (state) {
+        case GlyphState::Checked:
+            p.fillRect(bounds, QColor(60, 60, 60)); // Highlight
+            break;
+        case GlyphState::Hover:
+            p.fillRect(bounds, QColor(50, 50, 50));
+            break;
+        case GlyphState::Normal:
+            p.fillRect(bounds, QColor(40, 40, 40));
+            break;
     }
 
     // Margins for the "Canvas" representation
     int m = 4;
-    QRect canvas = rect().adjusted(m, m, -m, -m);
+    QRect canvas = bounds.adjusted(m, m, -m, -m);
     
     // Draw Canvas Border
     p.setPen(QPen(QColor(100, 100, 100), 1));
@@ -2,6 +2,9 @@
 
 #include <QPushButton>
 #include <QPaintEvent>
+#include <QPixmap>
+
+class QPainter;
 
 enum class AnchorH { Left, Center, Right, Stretch };
 enum class AnchorV { Top, Middle, Bottom, Stretch };
@@ -17,6 +20,9 @@ public:
 
     AnchorH horizontal() const { return hAlign; }
     AnchorV vertical() const { return vAlign; }
+
+    /** Show a different preset (repaints only if it changed) */
+    void SetAnchor(AnchorH h, AnchorV v);
     
     // Get Unity-style anchor preset values
     AnchorPreset GetPresetValues() const;
@@ -25,6 +31,12 @@ protected:
     void paintEvent(QPaintEvent *event) override;
 
 private:
+    enum class GlyphState { Normal, Hover, Checked };
+
+    // Pre-rendered glyph from QPixmapCache; painting is a single blit
+    static QPixmap Glyph(AnchorH h, AnchorV v, GlyphState state, const QSize &size, qreal dpr);
+    static void DrawGlyph(QPainter &p, const QRect &bounds, AnchorH hAlign, AnchorV vAlign, GlyphState state);
+
     AnchorH hAlign;
     AnchorV vAlign;
 };
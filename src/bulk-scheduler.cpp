@@ -0,0 +1,296 @@
+#include "bulk-scheduler.hpp"
+#include <obs-frontend-api.h>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+#include "edit-scheduler.hpp"
+#include "pending-saves.hpp"
+#include "rect-transform.hpp"
+#include "trace-recorder.hpp"
+#include "transform-queue.hpp"
+
+// Schedulers to notify when states are restored (UI thread)
+static std::vector<BulkScheduler*> schedulers;
+
+// Pending state first: applies record there before it is written
+static std::string StoredState(obs_sceneitem_t *item)
+{
+    const RectTransform *pending = PendingSaves::Find(item);
+    if (pending) return pending->EncodeState();
+
+    RectTransform rt;
+    return RectTransform::LoadStored(item, rt) ? rt.EncodeState() : std::string();
+}
+
+// The part of the OBS transform that RectTransform::ApplyToSceneItem sets
+static void SaveTransform(obs_data_t *entry, obs_sceneitem_t *item)
+{
+    vec2 pos, bounds;
+    obs_sceneitem_get_pos(item, &pos);
+    obs_sceneitem_get_bounds(item, &bounds);
+    obs_data_set_double(entry, "pos_x", pos.x);
+    obs_data_set_double(entry, "pos_y", pos.y);
+    obs_data_set_double(entry, "bounds_x", bounds.x);
+    obs_data_set_double(entry, "bounds_y", bounds.y);
+    obs_data_set_int(entry, "alignment", obs_sceneitem_get_alignment(item));
+    obs_data_set_int(entry, "bounds_type", (int)obs_sceneitem_get_bounds_type(item));
+    obs_data_set_int(entry, "bounds_alignment", obs_sceneitem_get_bounds_alignment(item));
+}
+
+static void LoadTransform(obs_data_t *entry, obs_sceneitem_t *item)
+{
+    vec2 pos = {(float)obs_data_get_double(entry, "pos_x"), (float)obs_data_get_double(entry, "pos_y")};
+    vec2 bounds = {(float)obs_data_get_double(entry, "bounds_x"), (float)obs_data_get_double(entry, "bounds_y")};
+
+    obs_sceneitem_defer_update_begin(item);
+    obs_sceneitem_set_alignment(item, (uint32_t)obs_data_get_int(entry, "alignment"));
+    obs_sceneitem_set_bounds_type(item, (obs_bounds_type)obs_data_get_int(entry, "bounds_type"));
+    obs_sceneitem_set_bounds_alignment(item, (uint32_t)obs_data_get_int(entry, "bounds_alignment"));
+    obs_sceneitem_set_bounds(item, &bounds);
+    obs_sceneitem_set_pos(item, &pos);
+    obs_sceneitem_defer_update_end(item);
+}
+
+static void RestoreItem(obs_data_t *entry)
+{
+    obs_source_t *source = obs_get_source_by_uuid(obs_data_get_string(entry, "scene"));
+    if (!source) return;
+
+    obs_scene_t *scene = obs_group_or_scene_from_source(source);
+    obs_sceneitem_t *item = scene ? obs_scene_find_sceneitem_by_id(scene, obs_data_get_int(entry, "id")) : nullptr;
+    if (item) {
+        LoadTransform(entry, item);
+
+        // An empty state means nothing was stored before
+        RectTransform rt;
+        if (RectTransform::DecodeState(obs_data_get_string(entry, "state"), rt)) {
+            PendingSaves::Record(item, rt);
+        } else {
+            PendingSaves::Forget(item);
+            RectTransform::ClearStored(item);
+        }
+    }
+    obs_source_release(source);
+}
+
+static bool SameItems(const std::vector<BulkScheduler::Target> &a, const std::vector<BulkScheduler::Target> &b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const BulkScheduler::Target &x, const BulkScheduler::Target &y) { return x.item == y.item; });
+}
+
+static int64_t ChunkBudgetNs()
+{
+    // Leave most of the frame to rendering and the rest of the UI
+    return std::max<int64_t>(1000000, (int64_t)EditScheduler::FrameIntervalMs() * 1000000 / 4);
+}
+
+BulkScheduler::BulkScheduler(TransformQueue *queue, QObject *parent) : QObject(parent), queue(queue)
+{
+    timer = new QTimer(this);
+    timer->setTimerType(Qt::PreciseTimer);
+    connect(timer, &QTimer::timeout, this, &BulkScheduler::OnFrame);
+    schedulers.push_back(this);
+}
+
+BulkScheduler::~BulkScheduler()
+{
+    schedulers.erase(std::remove(schedulers.begin(), schedulers.end(), this), schedulers.end());
+    Release();
+}
+
+std::string BulkScheduler::SaveStates(const std::vector<Target> &items)
+{
+    // Exactly the operation's items: the selection may have changed by the
+    // time the "after" state is taken, so obs_scene_save_transform_states
+    // (which saves the live selection) could miss or add items
+    obs_data_array_t *rects = obs_data_array_create();
+    for (const Target &t : items) {
+        obs_source_t *parent = obs_scene_get_source(obs_sceneitem_get_scene(t.item));
+        obs_data_t *entry = obs_data_create();
+        obs_data_set_string(entry, "scene", obs_source_get_uuid(parent));
+        obs_data_set_int(entry, "id", obs_sceneitem_get_id(t.item));
+        SaveTransform(entry, t.item);
+        obs_data_set_string(entry, "state", StoredState(t.item).c_str());
+        obs_data_array_push_back(rects, entry);
+        obs_data_release(entry);
+    }
+
+    obs_data_t *data = obs_data_create();
+    obs_data_set_array(data, "rect", rects);
+    std::string json = obs_data_get_json(data);
+
+    obs_data_release(data);
+    obs_data_array_release(rects);
+    return json;
+}
+
+void BulkScheduler::LoadStates(const char *json)
+{
+    obs_data_t *data = obs_data_create_from_json(json);
+    if (!data) return;
+
+    obs_data_array_t *rects = obs_data_get_array(data, "rect");
+    size_t count = obs_data_array_count(rects);
+    for (size_t i = 0; i < count; i++) {
+        obs_data_t *entry = obs_data_array_item(rects, i);
+        RestoreItem(entry);
+        obs_data_release(entry);
+    }
+    obs_data_array_release(rects);
+    obs_data_release(data);
+
+    for (BulkScheduler *scheduler : schedulers) emit scheduler->Restored();
+}
+
+void BulkScheduler::Start(const char *opName, bool opRepeatable, obs_scene_t *opScene, std::vector<Target> opTargets,
+                          Step opStep)
+{
+    if (!opScene || opTargets.empty()) return;
+
+    bool merge = Running() && opRepeatable && repeatable && scene == opScene && name == opName &&
+                 SameItems(targets, opTargets);
+    if (merge) {
+        // The remaining items will get the newer values; keep the old "before" state
+        timer->stop();
+        for (const Target &t : targets) obs_sceneitem_release(t.item);
+        targets.clear();
+        stats.merged++;
+    } else {
+        if (Running()) {
+            Finish();
+            if (committing) {
+                DrainQueue();
+                Commit();
+            }
+        }
+        scene = obs_scene_get_ref(opScene);
+        beforeState = SaveStates(opTargets);
+    }
+
+    name = opName;
+    repeatable = opRepeatable;
+    targets = std::move(opTargets);
+    for (const Target &t : targets) obs_sceneitem_addref(t.item);
+    next = 0;
+    step = std::move(opStep);
+    running = true;
+    committing = false;
+    stats.operations++;
+
+    // Small operations complete right here
+    if (RunChunk(ChunkBudgetNs())) {
+        StepsDone();
+        return;
+    }
+
+    emit Progress((int)next, (int)targets.size());
+    timer->start(EditScheduler::FrameIntervalMs());
+}
+
+void BulkScheduler::Cancel()
+{
+    if (!Running()) return;
+
+    timer->stop();
+    running = false;
+    committing = false;
+
+    // Queued transforms must land before they are rolled back
+    DrainQueue();
+    if (!beforeState.empty()) LoadStates(beforeState.c_str());
+
+    Release();
+    stats.cancelled++;
+    emit Finished(true);
+}
+
+void BulkScheduler::Finish()
+{
+    if (!running) return;
+
+    timer->stop();
+    RunChunk(INT64_MAX);
+    StepsDone();
+}
+
+void BulkScheduler::OnFrame()
+{
+    if (running) {
+        if (RunChunk(ChunkBudgetNs())) StepsDone();
+        else emit Progress((int)next, (int)targets.size());
+        return;
+    }
+
+    if (committing && (!queue || queue->Empty())) Commit();
+}
+
+bool BulkScheduler::RunChunk(int64_t budgetNs)
+{
+    TraceRecorder::Scope trace("bulk chunk");
+    QElapsedTimer elapsed;
+    elapsed.start();
+    stats.chunks++;
+
+    size_t first = next;
+    size_t end = targets.size();
+    while (next < end) {
+        const Target &t = targets[next++];
+        step(t.item, t.parentW, t.parentH);
+
+        // Reading the clock isn't free either
+        if ((next & 15) == 0 && elapsed.nsecsElapsed() >= budgetNs) break;
+    }
+
+    stats.steps += next - first;
+    stats.stepNs += (uint64_t)elapsed.nsecsElapsed();
+    return next == end;
+}
+
+void BulkScheduler::StepsDone()
+{
+    running = false;
+    committing = true;
+
+    // The "after" state is only complete once the tick thread applied everything
+    if (!queue || queue->Empty()) {
+        Commit();
+    } else if (!timer->isActive()) {
+        timer->start(EditScheduler::FrameIntervalMs());
+    }
+}
+
+void BulkScheduler::Commit()
+{
+    timer->stop();
+    committing = false;
+
+    std::string afterState = SaveStates(targets);
+    if (!beforeState.empty() && !afterState.empty() && beforeState != afterState) {
+        obs_frontend_add_undo_redo_action(name.c_str(), LoadStates, LoadStates, beforeState.c_str(),
+                                          afterState.c_str(), repeatable);
+    }
+
+    Release();
+    emit Finished(false);
+}
+
+void BulkScheduler::DrainQueue()
+{
+    // Apply what the tick thread hasn't reached yet here instead of waiting
+    // for it (which stalls the UI, or never ends while video is stalled)
+    if (queue) queue->Drain();
+}
+
+void BulkScheduler::Release()
+{
+    for (const Target &t : targets) obs_sceneitem_release(t.item);
+    targets.clear();
+    next = 0;
+    step = nullptr;
+
+    obs_scene_release(scene);
+    scene = nullptr;
+    beforeState.clear();
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QObject>
+#include <obs.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class QTimer;
+class TransformQueue;
+
+/**
+ * Frame-budgeted execution of layout operations on many scene items
+ *
+ * An operation is a list of targets (item + parent size) and a per-item
+ * step that ends in RectTransform::ApplyToSceneItem (directly or through
+ * the transform queue). The first chunk runs right away, so operations on
+ * a handful of items finish synchronously; larger ones continue with one
+ * chunk per output frame, each limited to a quarter of the frame interval.
+ *
+ * The OBS transform and the RectTransform state of the targets are
+ * captured before the first step and after the last one has been applied;
+ * both are registered as a single frontend undo action. Cancel() rolls back everything applied so far. Restoring either
+ * way emits Restored() on every scheduler, as cached RectTransform state
+ * no longer matches the items.
+ *
+ * UI thread only.
+ */
+class BulkScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    struct Target {
+        obs_sceneitem_t *item;
+        uint32_t parentW;
+        uint32_t parentH;
+    };
+
+    using Step = std::function<void(obs_sceneitem_t *item, uint32_t parentW, uint32_t parentH)>;
+
+    struct Stats {
+        uint64_t operations = 0;
+        uint64_t chunks = 0;    // Including the synchronous first chunk
+        uint64_t cancelled = 0;
+        uint64_t merged = 0;    // Repeatable operations folded into the previous one
+        uint64_t steps = 0;     // Items edited
+        uint64_t stepNs = 0;    // Time spent in steps (per-item cost = stepNs / steps)
+    };
+
+    explicit BulkScheduler(TransformQueue *queue, QObject *parent = nullptr);
+    ~BulkScheduler() override;
+
+    /**
+     * Start an operation; takes a reference on every target item. A running
+     * operation with the same name and 'repeatable' set is superseded and
+     * shares its undo unit with this one, any other is finished first.
+     */
+    void Start(const char *name, bool repeatable, obs_scene_t *scene, std::vector<Target> targets, Step step);
+
+    /** Stop and restore the transforms from before the operation */
+    void Cancel();
+
+    /** Run the remaining steps now (e.g. on shutdown) */
+    void Finish();
+
+    /** True while steps remain or the undo action is not registered yet */
+    bool Running() const { return running || committing; }
+
+    const Stats &GetStats() const { return stats; }
+
+signals:
+    void Progress(int done, int total);
+    void Finished(bool cancelled);
+    void Restored();
+
+private slots:
+    void OnFrame();
+
+private:
+    bool RunChunk(int64_t budgetNs);
+    void StepsDone();
+    void Commit();
+    void DrainQueue();
+    void Release();
+
+    static std::string SaveStates(const std::vector<Target> &items);
+    static void LoadStates(const char *data);
+
+    TransformQueue *queue;
+    QTimer *timer;
+
+    std::string name;
+    bool repeatable = false;
+    obs_scene_t *scene = nullptr;
+    std::string beforeState;
+
+    std::vector<Target> targets;
+    size_t next = 0;
+    Step step;
+
+    bool running = false;    // Steps remaining
+    bool committing = false; // Steps done, waiting for queued transforms
+
+    Stats stats;
+};
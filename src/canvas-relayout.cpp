@@ -0,0 +1,128 @@
+#include "canvas-relayout.hpp"
+#include <plugin-support.h>
+#include <QMetaObject>
+#include <util/platform.h>
+#include <vector>
+#include "rect-transform.hpp"
+#include "rect-transform-batch.hpp"
+#include "scene-visit.hpp"
+
+namespace {
+
+// Anchored root-level items collected from all scenes
+struct Collected {
+    bool widthChanged;
+    bool heightChanged;
+    uint32_t oldW;
+    uint32_t oldH;
+    uint64_t visited = 0;
+
+    std::vector<obs_sceneitem_t*> items;
+    RectTransformBatch batch;
+    std::vector<float> pivotX, pivotY, w, h;
+};
+
+void CollectItem(Collected &c, obs_sceneitem_t *item)
+{
+    c.visited++;
+
+    RectTransform rt;
+    if (!RectTransform::LoadAnchors(item, rt)) return;
+
+    if (!(c.widthChanged && rt.DependsOnWidth()) && !(c.heightChanged && rt.DependsOnHeight())) return;
+
+    float px, py, w, h;
+    RectTransform::ReadLiveRect(item, c.oldH, px, py, w, h);
+    c.pivotX.push_back(px);
+    c.pivotY.push_back(py);
+    c.w.push_back(w);
+    c.h.push_back(h);
+    c.batch.Add(rt, c.oldW, c.oldH);
+
+    obs_sceneitem_addref(item);
+    c.items.push_back(item);
+}
+
+bool CollectScene(void *param, obs_source_t *source)
+{
+    Collected &c = *reinterpret_cast<Collected*>(param);
+    obs_scene_t *scene = obs_scene_from_source(source);
+    if (scene) SceneVisit::EnumItems(scene, [&c](obs_scene_t *, obs_sceneitem_t *item) { CollectItem(c, item); });
+    return true;
+}
+
+} // namespace
+
+CanvasRelayout::CanvasRelayout(QObject *parent) : QObject(parent)
+{
+    ReadCanvas(canvasW, canvasH);
+    signal_handler_connect(obs_get_signal_handler(), "video_reset", OBSVideoReset, this);
+}
+
+CanvasRelayout::~CanvasRelayout()
+{
+    signal_handler_disconnect(obs_get_signal_handler(), "video_reset", OBSVideoReset, this);
+}
+
+bool CanvasRelayout::ReadCanvas(uint32_t &w, uint32_t &h)
+{
+    obs_video_info ovi;
+    if (!obs_get_video_info(&ovi) || !ovi.base_width || !ovi.base_height) return false;
+
+    w = ovi.base_width;
+    h = ovi.base_height;
+    return true;
+}
+
+void CanvasRelayout::OBSVideoReset(void *param, calldata_t *)
+{
+    QMetaObject::invokeMethod(reinterpret_cast<CanvasRelayout*>(param), "OnVideoReset", Qt::QueuedConnection);
+}
+
+void CanvasRelayout::OnVideoReset()
+{
+    uint32_t newW, newH;
+    if (!ReadCanvas(newW, newH)) return;
+    if (newW == canvasW && newH == canvasH) return;
+
+    uint32_t oldW = canvasW;
+    uint32_t oldH = canvasH;
+    canvasW = newW;
+    canvasH = newH;
+
+    // Nothing to convert from if the old size was never known
+    if (!oldW || !oldH) {
+        emit Resized();
+        return;
+    }
+
+    uint64_t start = os_gettime_ns();
+    stats.resets++;
+
+    Collected c;
+    c.widthChanged = newW != oldW;
+    c.heightChanged = newH != oldH;
+    c.oldW = oldW;
+    c.oldH = oldH;
+    obs_enum_scenes(CollectScene, &c);
+
+    // Offsets against the old canvas in one vectorized pass
+    size_t n = c.items.size();
+    c.batch.SolveOffsets(c.pivotX.data(), c.pivotY.data(), c.w.data(), c.h.data());
+
+    uint64_t changed = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (c.batch.Get(i).ApplyToSceneItem(c.items[i], newW, newH)) changed++;
+        obs_sceneitem_release(c.items[i]);
+    }
+
+    stats.visited += c.visited;
+    stats.relaidOut += n;
+    stats.changed += changed;
+
+    obs_log(LOG_INFO, "canvas %ux%u -> %ux%u: re-applied %zu of %llu items (%llu changed) in %.2f ms", oldW, oldH,
+            newW, newH, n, (unsigned long long)c.visited, (unsigned long long)changed,
+            (double)(os_gettime_ns() - start) / 1000000.0);
+
+    emit Resized();
+}
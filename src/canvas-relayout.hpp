@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QObject>
+#include <obs.h>
+#include <cstdint>
+
+/**
+ * Responsive re-layout of anchored items when the base canvas changes
+ *
+ * Listens for the core "video_reset" signal and remembers the canvas size
+ * the layout was last valid for. When the size changed, every root-level
+ * item of every scene that has stored anchors is reverse-engineered
+ * against the old size (batched) and applied again for the new one.
+ *
+ * Only items that depend on a changed dimension are touched:
+ * - width: anchorMinX or anchorMaxX is non-zero (x = W * anchor + ...)
+ * - height: anchorMinY or anchorMaxY is not 1 (OBS y = H * (1 - anchor)
+ *   + ... after the Y flip)
+ *
+ * Items inside groups are relative to the group, not to the canvas.
+ * The signal is forwarded to the UI thread, where all work happens.
+ */
+class CanvasRelayout : public QObject {
+    Q_OBJECT
+
+public:
+    struct Stats {
+        uint64_t resets = 0;    // Video resets that changed the canvas size
+        uint64_t visited = 0;   // Root-level items looked at
+        uint64_t relaidOut = 0; // Anchored items that depend on the change
+        uint64_t changed = 0;   // ... of which actually moved or resized
+    };
+
+    explicit CanvasRelayout(QObject *parent = nullptr);
+    ~CanvasRelayout() override;
+
+    const Stats &GetStats() const { return stats; }
+
+signals:
+    /** Canvas size changed (anchored items already re-applied) */
+    void Resized();
+
+private slots:
+    void OnVideoReset();
+
+private:
+    static void OBSVideoReset(void *param, calldata_t *data);
+    static bool ReadCanvas(uint32_t &w, uint32_t &h);
+
+    uint32_t canvasW = 0;
+    uint32_t canvasH = 0;
+    Stats stats;
+};
@@ -0,0 +1,96 @@
+#include "dock-view-model.hpp"
+#include <QCheckBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QStackedLayout>
+#include <QString>
+#include "rect-transform.hpp"
+#include "trace-recorder.hpp"
+
+bool DockViewModel::MatchPreset(const RectTransform &rt, AnchorH &h, AnchorV &v)
+{
+    for (int vi = 0; vi < 4; vi++) {
+        for (int hi = 0; hi < 4; hi++) {
+            const AnchorPreset &p = anchorPresets[vi][hi];
+            if (p.minX == rt.anchorMinX && p.minY == rt.anchorMinY && p.maxX == rt.anchorMaxX &&
+                p.maxY == rt.anchorMaxY) {
+                h = static_cast<AnchorH>(hi);
+                v = static_cast<AnchorV>(vi);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool DockViewModel::Differs(Field field, bool changed)
+{
+    if (changed || (stale & Bit(field))) {
+        stats.applied++;
+        return true;
+    }
+    stats.skipped++;
+    return false;
+}
+
+void DockViewModel::Show(const State &next, bool keepSize, bool keepPosition)
+{
+    TraceRecorder::Scope trace("widget update");
+
+    if (Differs(Field::Selection, next.hasSelection != shown.hasSelection)) {
+        widgets.stack->setCurrentWidget(next.hasSelection ? widgets.controls : widgets.noSelection);
+        Pushed(Field::Selection);
+    }
+    shown.hasSelection = next.hasSelection;
+
+    // Controls keep their last values while nothing is selected
+    if (!next.hasSelection) return;
+
+    // Don't overwrite values the user typed that are still waiting for their
+    // frame; skipped fields stay stale until the next push
+    auto pushSpin = [this](Field field, QSpinBox *spin, int value, int &current) {
+        if (!Differs(field, value != current)) return;
+        spin->blockSignals(true);
+        spin->setValue(value);
+        spin->blockSignals(false);
+        current = value;
+        Pushed(field);
+    };
+    if (!keepSize) {
+        pushSpin(Field::W, widgets.w, next.w, shown.w);
+        pushSpin(Field::H, widgets.h, next.h, shown.h);
+    }
+    if (!keepPosition) {
+        pushSpin(Field::X, widgets.x, next.x, shown.x);
+        pushSpin(Field::Y, widgets.y, next.y, shown.y);
+    }
+
+    // The text being typed wins until editing finishes (focus leaves)
+    bool typingName = (stale & Bit(Field::Name)) && widgets.name->hasFocus();
+    if (!typingName && Differs(Field::Name, next.name != shown.name)) {
+        widgets.name->blockSignals(true);
+        widgets.name->setText(QString::fromUtf8(next.name.c_str()));
+        widgets.name->blockSignals(false);
+        shown.name = next.name;
+        Pushed(Field::Name);
+    }
+
+    if (Differs(Field::Visible, next.visible != shown.visible)) {
+        widgets.visible->blockSignals(true);
+        widgets.visible->setChecked(next.visible);
+        widgets.visible->blockSignals(false);
+        shown.visible = next.visible;
+        Pushed(Field::Visible);
+    }
+
+    // Custom anchors keep whatever preset was shown last
+    if (next.hasPreset && Differs(Field::Anchor, !shown.hasPreset || next.anchorH != shown.anchorH ||
+                                                     next.anchorV != shown.anchorV)) {
+        widgets.anchor->SetAnchor(next.anchorH, next.anchorV);
+        shown.hasPreset = true;
+        shown.anchorH = next.anchorH;
+        shown.anchorV = next.anchorV;
+        Pushed(Field::Anchor);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "anchor-button.hpp"
+
+class QCheckBox;
+class QLabel;
+class QLineEdit;
+class QSpinBox;
+class QStackedLayout;
+class QWidget;
+struct RectTransform;
+
+/**
+ * What the dock currently displays, diffed before any widget is touched
+ *
+ * Every setter on a Qt widget can trigger relayout, repaint and text
+ * shaping even when the value is unchanged. Show() compares the new state
+ * with the last one pushed and only updates (and blocks signals on) the
+ * widgets whose field changed.
+ *
+ * Values the user is typing belong to the widget: UserEdited(field) forgets
+ * what that one field displays so the next Show() pushes it again. The
+ * name is not pushed while the user is typing in it (focus + edited), so
+ * a refresh never resets the text or the cursor.
+ */
+class DockViewModel {
+public:
+    struct State {
+        bool hasSelection = false;
+        std::string name;
+        bool visible = false;
+        int x = 0, y = 0;
+        int w = 0, h = 0;
+        bool hasPreset = false; // Anchors match one of the 16 presets
+        AnchorH anchorH = AnchorH::Center;
+        AnchorV anchorV = AnchorV::Middle;
+    };
+
+    struct Widgets {
+        QStackedLayout *stack;
+        QWidget *controls;
+        QLabel *noSelection;
+        QLineEdit *name;
+        QCheckBox *visible;
+        QSpinBox *x, *y, *w, *h;
+        AnchorButton *anchor;
+    };
+
+    enum class Field { Selection, Name, Visible, X, Y, W, H, Anchor };
+
+    struct Stats {
+        uint64_t applied = 0; // Widget setters called
+        uint64_t skipped = 0; // ... avoided because the field was unchanged
+    };
+
+    explicit DockViewModel(const Widgets &widgets) : widgets(widgets) {}
+
+    /** Anchor preset the stored anchors correspond to, if any */
+    static bool MatchPreset(const RectTransform &rt, AnchorH &h, AnchorV &v);
+
+    /**
+     * Push 'next' to the widgets. Size/position fields are left alone while
+     * the user's edit is still waiting for its frame.
+     */
+    void Show(const State &next, bool keepSize, bool keepPosition);
+
+    /** The user changed this field's widget; its displayed value is no longer known */
+    void UserEdited(Field field) { stale |= Bit(field); }
+
+    const Stats &GetStats() const { return stats; }
+
+private:
+    static unsigned Bit(Field field) { return 1u << static_cast<unsigned>(field); }
+
+    /** Counts the update; true if the field has to be pushed */
+    bool Differs(Field field, bool changed);
+
+    /** Field pushed; the widget shows the model's value again */
+    void Pushed(Field field) { stale &= ~Bit(field); }
+
+    Widgets widgets;
+    State shown;
+    unsigned stale = ~0u; // Fields whose widget value is unknown
+    Stats stats;
+};
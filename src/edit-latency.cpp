@@ -0,0 +1,80 @@
+#include "edit-latency.hpp"
+#include <util/platform.h>
+#include <algorithm>
+
+EditLatency::EditLatency(size_t window)
+{
+    samples.reserve(window ? window : 1);
+}
+
+void EditLatency::Input()
+{
+    if (pendingNs) return;
+    CloseWindow();
+    pendingNs = os_gettime_ns();
+}
+
+uint64_t EditLatency::TakeInput()
+{
+    uint64_t ns = pendingNs;
+    pendingNs = 0;
+    return ns;
+}
+
+void EditLatency::InFlight(uint64_t inputNs)
+{
+    if (inputNs && (!inFlightNs || inputNs < inFlightNs)) inFlightNs = inputNs;
+}
+
+void EditLatency::Landed(uint64_t inputNs, uint64_t landedNs)
+{
+    if (!inputNs || landedNs < inputNs) return;
+
+    uint64_t us = (landedNs - inputNs) / 1000;
+    uint32_t sample = (uint32_t)std::min<uint64_t>(us, UINT32_MAX);
+    if (samples.size() < samples.capacity()) {
+        samples.push_back(sample);
+    } else {
+        samples[nextSample] = sample;
+        nextSample = (nextSample + 1) % samples.size();
+    }
+
+    totals.edits++;
+    totals.maxUs = std::max(totals.maxUs, us);
+    landedSinceInput = true;
+}
+
+void EditLatency::Finished(bool cancelled, uint64_t lastApplyNs)
+{
+    uint64_t inputNs = inFlightNs;
+    inFlightNs = 0;
+    if (cancelled || !inputNs) return;
+
+    // Queued transforms landed on the tick thread, possibly a frame before this
+    uint64_t now = os_gettime_ns();
+    Landed(inputNs, lastApplyNs > inputNs ? std::min(lastApplyNs, now) : now);
+}
+
+void EditLatency::CloseWindow()
+{
+    if (landedSinceInput && refreshes > 1) totals.redundantRefreshes += refreshes - 1;
+    landedSinceInput = false;
+    refreshes = 0;
+}
+
+EditLatency::Summary EditLatency::Summarize() const
+{
+    Summary summary = totals;
+    if (landedSinceInput && refreshes > 1) summary.redundantRefreshes += refreshes - 1;
+    if (samples.empty()) return summary;
+
+    std::vector<uint32_t> sorted(samples);
+    auto percentile = [&](size_t pct) {
+        size_t i = std::min(sorted.size() - 1, sorted.size() * pct / 100);
+        std::nth_element(sorted.begin(), sorted.begin() + (ptrdiff_t)i, sorted.end());
+        return (uint64_t)sorted[i];
+    };
+    summary.p50Us = percentile(50);
+    summary.p99Us = percentile(99);
+    return summary;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Input-to-scene latency of dock edits
+ *
+ * An edit starts with the first user input that has not been applied yet
+ * (spin box value, anchor preset click) and ends when its transforms are
+ * in the scene: when the tick thread applied the last queued command, or
+ * when the bulk operation finished if everything was applied directly.
+ * Inputs that merge into a running operation count from the earliest one,
+ * which is the delay the user sees.
+ *
+ * Selection refreshes between two edits are counted as well; more than
+ * one per edit means the dock redid work it didn't need to.
+ *
+ * UI thread only. The last 'window' latencies are kept for percentiles.
+ */
+class EditLatency {
+public:
+    struct Summary {
+        uint64_t edits = 0;              // Completed edits
+        uint64_t p50Us = 0;              // Over the kept window
+        uint64_t p99Us = 0;
+        uint64_t maxUs = 0;              // Since start
+        uint64_t redundantRefreshes = 0; // Refreshes beyond the first per edit
+    };
+
+    explicit EditLatency(size_t window = 4096);
+
+    /** User input arrived (no-op if an earlier input is still unapplied) */
+    void Input();
+
+    /** Take the unapplied input into the operation being started (0 if none) */
+    uint64_t TakeInput();
+
+    /** Operation for 'inputNs' runs asynchronously / already landed */
+    void InFlight(uint64_t inputNs);
+    void Landed(uint64_t inputNs, uint64_t landedNs);
+
+    /** Asynchronous operation completed; 'lastApplyNs' is the last tick-thread apply */
+    void Finished(bool cancelled, uint64_t lastApplyNs);
+
+    /** RefreshFromSelection ran */
+    void Refresh() { refreshes++; }
+
+    Summary Summarize() const;
+
+private:
+    void CloseWindow();
+
+    uint64_t pendingNs = 0;  // Oldest unapplied input
+    uint64_t inFlightNs = 0; // Oldest input of the running operation
+    uint64_t refreshes = 0;  // Since the last edit's input
+    bool landedSinceInput = false;
+
+    std::vector<uint32_t> samples; // Microseconds, ring
+    size_t nextSample = 0;
+    Summary totals;
+};
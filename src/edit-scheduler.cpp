@@ -0,0 +1,56 @@
+#include "edit-scheduler.hpp"
+#include <obs.h>
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+
+EditScheduler::EditScheduler(std::function<void()> flush, QObject *parent)
+    : QObject(parent), flush(std::move(flush))
+{
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    timer->setTimerType(Qt::PreciseTimer);
+    connect(timer, &QTimer::timeout, this, &EditScheduler::OnTimer);
+}
+
+int EditScheduler::FrameIntervalMs()
+{
+    obs_video_info ovi;
+    if (!obs_get_video_info(&ovi) || !ovi.fps_num) return 16;
+    return std::max(1, (int)((1000ull * ovi.fps_den + ovi.fps_num - 1) / ovi.fps_num));
+}
+
+void EditScheduler::Request()
+{
+    if (pending) {
+        // Superseded by this value before it was applied
+        dropped++;
+        return;
+    }
+    pending = true;
+
+    // Leading edge: a single edit applies right away
+    int interval = FrameIntervalMs();
+    qint64 sinceLast = lastApply.isValid() ? lastApply.elapsed() : interval;
+    if (sinceLast >= interval) {
+        Flush();
+    } else {
+        timer->start((int)(interval - sinceLast));
+    }
+}
+
+void EditScheduler::Flush()
+{
+    timer->stop();
+    if (!pending) return;
+
+    pending = false;
+    applied++;
+    lastApply.start();
+    flush();
+}
+
+void EditScheduler::OnTimer()
+{
+    Flush();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <cstdint>
+#include <functional>
+
+class QTimer;
+
+/**
+ * Frame-aligned, latest-value-wins edit throttling
+ *
+ * Widgets call Request() for every new value (keystroke, wheel tick, held
+ * arrow key). The flush callback runs at most once per output frame, using
+ * the frame interval from obs_get_video_info, and reads the newest widget
+ * values itself, so intermediate values are simply dropped.
+ */
+class EditScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit EditScheduler(std::function<void()> flush, QObject *parent = nullptr);
+
+    /** A new value arrived; applies now or at the start of the next frame */
+    void Request();
+
+    /** Apply a pending edit immediately */
+    void Flush();
+
+    /** True while a newer value has not been applied yet */
+    bool Pending() const { return pending; }
+
+    uint64_t Applied() const { return applied; }
+    uint64_t Dropped() const { return dropped; }
+
+    /** Output frame interval in ms (from obs_get_video_info) */
+    static int FrameIntervalMs();
+
+private slots:
+    void OnTimer();
+
+private:
+    std::function<void()> flush;
+    QTimer *timer;
+    QElapsedTimer lastApply;
+    bool pending = false;
+
+    uint64_t applied = 0;
+    uint64_t dropped = 0;
+};
@@ -0,0 +1,144 @@
+#include "group-layout.hpp"
+#include <plugin-support.h>
+#include <QTimer>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "edit-scheduler.hpp"
+#include "group-solver.hpp"
+#include "pending-saves.hpp"
+#include "rect-transform.hpp"
+#include "selection-tracker.hpp"
+
+GroupLayout::GroupLayout(SelectionTracker *tracker, QObject *parent) : QObject(parent), tracker(tracker)
+{
+    timer = new QTimer(this);
+    timer->setSingleShot(true);
+    timer->setTimerType(Qt::PreciseTimer);
+    connect(timer, &QTimer::timeout, this, &GroupLayout::OnFrame);
+}
+
+void GroupLayout::MarkDirty(obs_sceneitem_t *group, uint32_t oldW, uint32_t oldH)
+{
+    if (!group) return;
+
+    // Once laid out, a node knows its size better than the tracker: the
+    // solver may have laid it out for a size OBS only reaches afterwards
+    auto inserted = nodes.try_emplace(group);
+    Node &node = inserted.first->second;
+    if (inserted.second) {
+        node.laidOutW = oldW;
+        node.laidOutH = oldH;
+    }
+    node.dirty = true;
+
+    if (!timer->isActive()) timer->start(EditScheduler::FrameIntervalMs());
+}
+
+void GroupLayout::Clear()
+{
+    timer->stop();
+    nodes.clear();
+}
+
+void GroupLayout::OnFrame()
+{
+    const SceneGraphMirror &mirror = tracker->Mirror();
+    RectTransformCache &cache = tracker->Transforms();
+
+    // Dirty groups that still exist, top-down
+    std::vector<std::pair<uint32_t, obs_sceneitem_t*>> dirty;
+    for (auto it = nodes.begin(); it != nodes.end();) {
+        const SceneGraphMirror::Node *mirrored = mirror.Find(it->first);
+        if (!mirrored) {
+            it = nodes.erase(it);
+            continue;
+        }
+        if (it->second.dirty) dirty.emplace_back(mirrored->order, it->first);
+        ++it;
+    }
+    if (dirty.empty()) return;
+    std::sort(dirty.begin(), dirty.end());
+
+    // Each dirty node is laid out once; resizes caused by this pass (nested
+    // groups picking up their children's new bounds) arrive through the
+    // tracker afterwards and are handled next frame
+    stats.frames++;
+    bool anyApplied = false;
+
+    for (const auto &entry : dirty) {
+        obs_sceneitem_t *group = entry.second;
+        Node &node = nodes[group];
+
+        obs_source_t *source = obs_sceneitem_get_source(group);
+        uint32_t w = source ? obs_source_get_width(source) : 0;
+        uint32_t h = source ? obs_source_get_height(source) : 0;
+        node.dirty = false;
+        if ((w == node.laidOutW && h == node.laidOutH) || !w || !h) continue;
+
+        stats.nodesVisited++;
+        std::vector<GroupSolver::Child> children;
+        mirror.ForEachChild(group, [&](obs_sceneitem_t *item, uint32_t, uint32_t) {
+            GroupSolver::Child child;
+            child.item = item;
+            GroupSolver::ReadBox(item, child);
+
+            RectTransform anchors;
+            if (RectTransform::LoadAnchors(item, anchors) && (anchors.DependsOnWidth() || anchors.DependsOnHeight())) {
+                // Offsets relative to the size the child was laid out for
+                child.dependent = true;
+                child.rt = cache.Load(item, node.laidOutW, node.laidOutH);
+            }
+            children.push_back(child);
+        });
+
+        // Stretch children can resize the group they are laid out in
+        GroupSolver::Result result = GroupSolver::Solve(children, w, h);
+        stats.solverPasses += (uint64_t)result.passes;
+        if (!result.converged) {
+            // Leave the children alone instead of drifting every frame; they
+            // stay laid out for the old size
+            ReportUnconverged(group, children, result);
+            continue;
+        }
+
+        for (const GroupSolver::Child &child : children) {
+            if (!child.dependent) continue;
+
+            // Place it in the group's current frame: once OBS moves the box
+            // corner back to the origin, the group has exactly the solved size
+            RectTransform placed = child.rt;
+            placed.anchoredPosX += result.originX;
+            placed.anchoredPosY -= result.originY; // OBS y points down
+            placed.ApplyToSceneItem(child.item, result.w, result.h, false);
+            PendingSaves::Record(child.item, child.rt);
+            cache.Store(child.item, child.rt, result.w, result.h);
+            stats.itemsApplied++;
+            anyApplied = true;
+        }
+
+        node.laidOutW = result.w;
+        node.laidOutH = result.h;
+    }
+
+    if (anyApplied) emit LaidOut();
+}
+
+void GroupLayout::ReportUnconverged(obs_sceneitem_t *group, const std::vector<GroupSolver::Child> &children,
+                                    const GroupSolver::Result &result)
+{
+    stats.unconverged++;
+
+    std::string items;
+    for (const GroupSolver::Child &child : children) {
+        if (!child.dependent || child.settled) continue;
+        obs_source_t *source = obs_sceneitem_get_source(child.item);
+        if (!items.empty()) items += ", ";
+        items += source ? obs_source_get_name(source) : "?";
+    }
+
+    obs_source_t *groupSource = obs_sceneitem_get_source(group);
+    obs_log(LOG_WARNING, "group '%s' did not settle after %d layout passes (last size %ux%u), not re-applied: %s",
+            groupSource ? obs_source_get_name(groupSource) : "?", result.passes, result.w, result.h,
+            items.empty() ? "origin keeps moving" : items.c_str());
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QObject>
+#include <obs.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "group-solver.hpp"
+
+class QTimer;
+class SelectionTracker;
+
+/**
+ * Layout tree of the tracked groups with per-node dirty flags
+ *
+ * A group's contents are the parent of its children's RectTransforms, so
+ * when they change size (SelectionTracker::GroupResized) the anchored
+ * children have to be laid out again. Each node remembers the size its
+ * children were last laid out for; a resize only marks the node dirty.
+ *
+ * Once per output frame the dirty nodes are processed top-down (parents
+ * before nested groups, in mirror order), each exactly once. GroupSolver
+ * finds the size at which the group and its anchored children agree, the
+ * children are applied once for that size; groups that don't settle are
+ * reported and left alone. Resizes this causes further down mark those
+ * nodes dirty for the next frame. Clean subtrees are never visited.
+ *
+ * The tracker stays attached while the dock is hidden, so groups keep
+ * being laid out whether or not the dock was ever shown.
+ *
+ * UI thread only.
+ */
+class GroupLayout : public QObject {
+    Q_OBJECT
+
+public:
+    struct Stats {
+        uint64_t frames = 0;        // Frames that processed dirty nodes
+        uint64_t nodesVisited = 0;  // Dirty groups laid out
+        uint64_t itemsApplied = 0;  // Children re-applied
+        uint64_t solverPasses = 0;  // Fixed-point passes over all visited groups
+        uint64_t unconverged = 0;   // Groups left alone because they did not settle
+    };
+
+    explicit GroupLayout(SelectionTracker *tracker, QObject *parent = nullptr);
+
+    /** Group contents changed size; children were laid out for oldW x oldH */
+    void MarkDirty(obs_sceneitem_t *group, uint32_t oldW, uint32_t oldH);
+
+    /** Forget all nodes (collection going away) */
+    void Clear();
+
+    const Stats &GetStats() const { return stats; }
+
+signals:
+    /** Children of at least one group were re-applied */
+    void LaidOut();
+
+private slots:
+    void OnFrame();
+
+private:
+    void ReportUnconverged(obs_sceneitem_t *group, const std::vector<GroupSolver::Child> &children,
+                           const GroupSolver::Result &result);
+
+    struct Node {
+        uint32_t laidOutW = 0; // Size the children were last laid out for
+        uint32_t laidOutH = 0;
+        bool dirty = false;
+    };
+
+    SelectionTracker *tracker;
+    QTimer *timer;
+    std::unordered_map<obs_sceneitem_t*, Node> nodes;
+    Stats stats;
+};
@@ -0,0 +1,97 @@
+#include "group-solver.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Group sizes are whole pixels; sub-pixel origin shifts are noise
+static const float originTolerance = 0.5f;
+
+static void LayOut(GroupSolver::Child &c, uint32_t w, uint32_t h)
+{
+    float x, y, rw, rh;
+    c.rt.CalculateFinalRect((float)w, (float)h, x, y, rw, rh);
+
+    // Unity-space (bottom-origin) to OBS group-local (top-origin)
+    float left = x;
+    float top = (float)h - (y + rh);
+    c.settled = std::fabs(left - c.left) <= originTolerance && std::fabs(top - c.top) <= originTolerance &&
+                std::fabs(left + rw - c.right) <= originTolerance && std::fabs(top + rh - c.bottom) <= originTolerance;
+    c.left = left;
+    c.top = top;
+    c.right = left + rw;
+    c.bottom = top + rh;
+}
+
+GroupSolver::Result GroupSolver::Solve(std::vector<Child> &children, uint32_t w, uint32_t h)
+{
+    Result result;
+    result.w = w;
+    result.h = h;
+    if (children.empty()) {
+        result.converged = true;
+        return result;
+    }
+
+    for (int pass = 0; pass < maxPasses; pass++) {
+        result.passes = pass + 1;
+
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+        for (Child &c : children) {
+            if (c.dependent) LayOut(c, result.w, result.h);
+            minX = std::min(minX, c.left);
+            minY = std::min(minY, c.top);
+            maxX = std::max(maxX, c.right);
+            maxY = std::max(maxY, c.bottom);
+        }
+
+        uint32_t nextW = (uint32_t)std::max(1L, std::lround(maxX - minX));
+        uint32_t nextH = (uint32_t)std::max(1L, std::lround(maxY - minY));
+        bool originStable = std::fabs(minX) <= originTolerance && std::fabs(minY) <= originTolerance;
+        if (nextW == result.w && nextH == result.h && originStable) {
+            result.converged = true;
+            return result;
+        }
+
+        // What OBS does next: move the box corner to the origin, resize the group
+        for (Child &c : children) {
+            if (c.dependent) continue;
+            c.left -= minX;
+            c.right -= minX;
+            c.top -= minY;
+            c.bottom -= minY;
+        }
+        result.originX += minX;
+        result.originY += minY;
+        result.w = nextW;
+        result.h = nextH;
+    }
+    return result;
+}
+
+void GroupSolver::ReadBox(obs_sceneitem_t *item, Child &child)
+{
+    float w = 0.0f, h = 0.0f;
+    if (obs_sceneitem_get_bounds_type(item) != OBS_BOUNDS_NONE) {
+        vec2 bounds;
+        obs_sceneitem_get_bounds(item, &bounds);
+        w = bounds.x;
+        h = bounds.y;
+    } else if (obs_source_t *source = obs_sceneitem_get_source(item)) {
+        vec2 scale;
+        obs_sceneitem_get_scale(item, &scale);
+        w = std::fabs((float)obs_source_get_width(source) * scale.x);
+        h = std::fabs((float)obs_source_get_height(source) * scale.y);
+    }
+
+    // 'pos' is the aligned point of the box
+    uint32_t align = obs_sceneitem_get_alignment(item);
+    float fx = (align & OBS_ALIGN_LEFT) ? 0.0f : (align & OBS_ALIGN_RIGHT) ? 1.0f : 0.5f;
+    float fy = (align & OBS_ALIGN_TOP) ? 0.0f : (align & OBS_ALIGN_BOTTOM) ? 1.0f : 0.5f;
+
+    vec2 pos;
+    obs_sceneitem_get_pos(item, &pos);
+    child.left = pos.x - w * fx;
+    child.top = pos.y - h * fy;
+    child.right = child.left + w;
+    child.bottom = child.top + h;
+}
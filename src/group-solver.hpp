@@ -0,0 +1,58 @@
+#pragma once
+
+#include <obs.h>
+#include <cstdint>
+#include <vector>
+#include "rect-transform.hpp"
+
+/**
+ * Fixed-point solver for groups whose size depends on their children
+ *
+ * OBS sizes a group to the bounding box of its children and moves the
+ * box's corner back to the group origin. A stretch-anchored child's size
+ * and position come from the group size, so re-applying it can resize
+ * the group again: a cycle that oscillates or grows on every pass.
+ *
+ * Solve() runs that loop on cached rects instead of the live items:
+ * dependent children are laid out for the candidate size, the others keep
+ * their live boxes (shifted like OBS would), and the bounding box gives
+ * the next candidate. It stops once size and origin are stable or after
+ * maxPasses; children still moving in the last pass did not converge.
+ *
+ * The dependent children's boxes end up in the frame OBS will have moved
+ * the group to. Applied in the group's current frame they have to be
+ * offset by Result::originX/Y, so that OBS' own shift (by the same amount)
+ * lands everything at the solved size in one step.
+ */
+class GroupSolver {
+public:
+    struct Child {
+        obs_sceneitem_t *item = nullptr;
+        RectTransform rt;       // Offsets valid for the size it was laid out for
+        bool dependent = false; // Laid out from the group size
+        bool settled = true;    // Rect unchanged in the last pass
+
+        // Group-local OBS box (top-origin), cached between passes
+        float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+    };
+
+    struct Result {
+        bool converged = false;
+        int passes = 0;
+        uint32_t w = 0; // Group size the dependent children settle at
+        uint32_t h = 0;
+
+        // Solved frame's origin in the group's current frame (sum of the
+        // shifts OBS applies on the way); add to the solved boxes to apply
+        float originX = 0.0f;
+        float originY = 0.0f;
+    };
+
+    static const int maxPasses = 8;
+
+    /** Iterate from the current group size */
+    static Result Solve(std::vector<Child> &children, uint32_t w, uint32_t h);
+
+    /** Live group-local box of an item (unrotated bounds or scaled source size) */
+    static void ReadBox(obs_sceneitem_t *item, Child &child);
+};
@@ -0,0 +1,77 @@
+#include "pending-saves.hpp"
+#include <util/platform.h>
+#include <algorithm>
+#include <unordered_map>
+
+static std::unordered_map<obs_sceneitem_t*, RectTransform> pending;
+static PendingSaves::Stats stats;
+
+bool PendingSaves::Record(obs_sceneitem_t *item, const RectTransform &rt)
+{
+    if (!item) return false;
+
+    stats.recorded++;
+    auto it = pending.find(item);
+    if (it != pending.end()) {
+        stats.coalesced++;
+        if (it->second.Matches(rt)) return false;
+        it->second = rt;
+        return true;
+    }
+
+    // Nothing to write later if the private settings already hold it, or
+    // hold a newer version's state that SaveToItem would not overwrite
+    RectTransform stored;
+    bool newer;
+    if (RectTransform::LoadStored(item, stored, &newer) ? stored.Matches(rt) : newer) return false;
+
+    obs_sceneitem_addref(item);
+    pending.emplace(item, rt);
+    return true;
+}
+
+const RectTransform *PendingSaves::Find(obs_sceneitem_t *item)
+{
+    if (pending.empty()) return nullptr;
+    auto it = pending.find(item);
+    return it != pending.end() ? &it->second : nullptr;
+}
+
+void PendingSaves::Forget(obs_sceneitem_t *item)
+{
+    auto it = pending.find(item);
+    if (it == pending.end()) return;
+
+    pending.erase(it);
+    obs_sceneitem_release(item);
+}
+
+size_t PendingSaves::Flush()
+{
+    if (pending.empty()) return 0;
+
+    uint64_t start = os_gettime_ns();
+    stats.flushes++;
+    size_t written = 0;
+    for (auto &entry : pending) {
+        if (entry.second.SaveToItem(entry.first)) written++;
+        obs_sceneitem_release(entry.first);
+    }
+    pending.clear();
+
+    uint64_t ns = os_gettime_ns() - start;
+    stats.written += written;
+    stats.flushNs += ns;
+    stats.maxFlushNs = std::max(stats.maxFlushNs, ns);
+    return written;
+}
+
+size_t PendingSaves::Size()
+{
+    return pending.size();
+}
+
+const PendingSaves::Stats &PendingSaves::GetStats()
+{
+    return stats;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <obs.h>
+#include <cstddef>
+#include <cstdint>
+#include "rect-transform.hpp"
+
+/**
+ * Write-behind store for RectTransform state
+ *
+ * Persisting to the private settings on every apply costs an obs_data
+ * write per item per edit during drags and scrubs, for state that only
+ * matters once the collection is written to disk. Applies record the
+ * state here instead and Flush() writes it in one batch: from the
+ * frontend save callback and before the collection goes away.
+ *
+ * Until flushed the pending copy is the item's state; LoadAnchors reads it
+ * before the private settings. Pending items are referenced.
+ *
+ * UI thread only.
+ */
+class PendingSaves {
+public:
+    struct Stats {
+        uint64_t recorded = 0;  // States recorded by applies
+        uint64_t coalesced = 0; // ... that replaced a not yet flushed state
+        uint64_t flushes = 0;   // Flushes with anything pending
+        uint64_t written = 0;   // Private settings actually written
+        uint64_t flushNs = 0;   // Time spent flushing
+        uint64_t maxFlushNs = 0;
+    };
+
+    /**
+     * Record 'rt' for 'item'. Returns false if it matches what is pending or
+     * stored, or the item holds a newer plugin version's state
+     */
+    static bool Record(obs_sceneitem_t *item, const RectTransform &rt);
+
+    /** Pending state of 'item', or nullptr */
+    static const RectTransform *Find(obs_sceneitem_t *item);
+
+    /** Drop the pending state of 'item' (nothing will be written for it) */
+    static void Forget(obs_sceneitem_t *item);
+
+    /** Write everything pending to the private settings. Returns items written */
+    static size_t Flush();
+
+    static size_t Size();
+    static const Stats &GetStats();
+};
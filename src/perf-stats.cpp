@@ -0,0 +1,121 @@
+#include "perf-stats.hpp"
+#include <obs.h>
+#include <plugin-support.h>
+#include <atomic>
+#include <cstdio>
+
+namespace {
+
+struct Counters {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> units{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> maxNs{0};
+    std::atomic<uint64_t> buckets[PerfStats::bucketCount] = {};
+};
+
+Counters counters[PerfStats::ProbeCount];
+
+int Bucket(uint64_t ns)
+{
+    int b = 0;
+    while (ns > 1 && b < PerfStats::bucketCount - 1) {
+        ns >>= 1;
+        b++;
+    }
+    return b;
+}
+
+} // namespace
+
+void PerfStats::Record(Probe probe, uint64_t ns, uint64_t units)
+{
+    Counters &c = counters[probe];
+    c.calls.fetch_add(1, std::memory_order_relaxed);
+    c.units.fetch_add(units, std::memory_order_relaxed);
+    c.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    c.buckets[Bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max = c.maxNs.load(std::memory_order_relaxed);
+    while (ns > max && !c.maxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+PerfStats::Snapshot PerfStats::Read(Probe probe)
+{
+    const Counters &c = counters[probe];
+    Snapshot s;
+    s.calls = c.calls.load(std::memory_order_relaxed);
+    s.units = c.units.load(std::memory_order_relaxed);
+    s.totalNs = c.totalNs.load(std::memory_order_relaxed);
+    s.maxNs = c.maxNs.load(std::memory_order_relaxed);
+    for (int b = 0; b < bucketCount; b++) s.buckets[b] = c.buckets[b].load(std::memory_order_relaxed);
+    return s;
+}
+
+PerfStats::Snapshot PerfStats::Delta(const Snapshot &now, const Snapshot &earlier)
+{
+    Snapshot d;
+    d.calls = now.calls - earlier.calls;
+    d.units = now.units - earlier.units;
+    d.totalNs = now.totalNs - earlier.totalNs;
+    d.maxIsBound = true;
+    for (int b = 0; b < bucketCount; b++) {
+        d.buckets[b] = now.buckets[b] - earlier.buckets[b];
+        if (d.buckets[b]) d.maxNs = (uint64_t)2 << b;
+    }
+    return d;
+}
+
+uint64_t PerfStats::Snapshot::PercentileNs(unsigned pct) const
+{
+    uint64_t recorded = 0;
+    for (uint64_t n : buckets) recorded += n;
+    if (!recorded) return 0;
+
+    uint64_t target = (recorded * pct + 99) / 100;
+    uint64_t seen = 0;
+    for (int b = 0; b < bucketCount; b++) {
+        seen += buckets[b];
+        if (seen >= target) return (uint64_t)2 << b;
+    }
+    return maxNs;
+}
+
+const char *PerfStats::Name(Probe probe)
+{
+    switch (probe) {
+        case Refresh: return "refresh";
+        case MirrorWalk: return "scene walk";
+        case LoadFromItem: return "load from item";
+        case ApplyToSceneItem: return "apply to item";
+        case SaveToItem: return "save to item";
+        case Signal: return "signal callback";
+        case ProbeCount: break;
+    }
+    return "?";
+}
+
+std::string PerfStats::Format(Probe probe)
+{
+    return Format(probe, Read(probe));
+}
+
+std::string PerfStats::Format(Probe probe, const Snapshot &s)
+{
+    double avgUs = s.calls ? (double)s.totalNs / (double)s.calls / 1000.0 : 0.0;
+
+    char line[256];
+    snprintf(line, sizeof(line), "%s: %llu calls, %llu units, avg %.1f us, p50 < %.1f us, p99 < %.1f us, max %s%.1f us",
+             Name(probe), (unsigned long long)s.calls, (unsigned long long)s.units, avgUs,
+             (double)s.PercentileNs(50) / 1000.0, (double)s.PercentileNs(99) / 1000.0, s.maxIsBound ? "< " : "",
+             (double)s.maxNs / 1000.0);
+    return line;
+}
+
+void PerfStats::LogSummary()
+{
+    for (int p = 0; p < ProbeCount; p++) {
+        if (Read((Probe)p).calls) obs_log(LOG_INFO, "perf %s", Format((Probe)p).c_str());
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <util/platform.h>
+
+/**
+ * Always-on counters and timing histograms for the plugin's hot paths
+ *
+ * Each probe keeps a call count, a unit count (e.g. items visited), total
+ * and max time and a log2 histogram of durations (bucket b holds calls
+ * that took [2^b, 2^(b+1)) ns). Recording is a clock read and a handful
+ * of relaxed atomic adds, cheap enough to leave on in production, and
+ * safe from any thread (applies run on the tick thread, signals on OBS
+ * threads).
+ */
+class PerfStats {
+public:
+    enum Probe {
+        Refresh,     // SourceResizerDock::RefreshFromSelection
+        MirrorWalk,  // SceneGraphMirror::Rebuild (scene walk under the scene mutexes)
+        LoadFromItem,
+        ApplyToSceneItem,
+        SaveToItem,
+        Signal,      // Scene/item signal callbacks
+        ProbeCount
+    };
+
+    static const int bucketCount = 40;
+
+    struct Snapshot {
+        uint64_t calls = 0;
+        uint64_t units = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t buckets[bucketCount] = {};
+        bool maxIsBound = false;  // maxNs is a bucket bound (windowed snapshots)
+
+        /** Upper bound of the bucket holding the given percentile (0-100) */
+        uint64_t PercentileNs(unsigned pct) const;
+    };
+
+    /** Times its scope into 'probe' */
+    class Scope {
+    public:
+        explicit Scope(Probe probe, uint64_t units = 1) : probe(probe), units(units), start(os_gettime_ns()) {}
+        ~Scope() { Record(probe, os_gettime_ns() - start, units); }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        /** Units known only at the end (e.g. items walked) */
+        void SetUnits(uint64_t n) { units = n; }
+
+    private:
+        Probe probe;
+        uint64_t units;
+        uint64_t start;
+    };
+
+    static void Record(Probe probe, uint64_t ns, uint64_t units = 1);
+    static Snapshot Read(Probe probe);
+    static const char *Name(Probe probe);
+
+    /**
+     * What happened between two Reads of the same probe, for rolling
+     * views over the cumulative counters. The exact max is not
+     * recoverable, so it is the upper bound of the highest bucket hit
+     */
+    static Snapshot Delta(const Snapshot &now, const Snapshot &earlier);
+
+    /** One line per probe: calls, units, avg/p50/p99/max */
+    static std::string Format(Probe probe);
+    static std::string Format(Probe probe, const Snapshot &s);
+
+    /** All probes with at least one call to the OBS log */
+    static void LogSummary();
+};
@@ -21,10 +21,41 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include <obs-frontend-api.h>
 #include "source-resizer-dock.hpp"
+#include "perf-stats.hpp"
+#include "trace-recorder.hpp"
+#include <util/platform.h>
+#include <QAction>
+#include <ctime>
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
 
+// Seconds of history written by "Save Source Resizer Trace" and when
+// "Record Source Resizer Trace" is unchecked
+static const double traceSeconds = 10.0;
+
+static void save_trace(void *)
+{
+	char *dir = obs_module_config_path("traces");
+	if (!dir) return;
+	os_mkdirs(dir);
+	bfree(dir);
+
+	char file[64];
+	time_t now = time(nullptr);
+	strftime(file, sizeof(file), "traces/trace-%Y%m%d-%H%M%S.json", localtime(&now));
+	char *path = obs_module_config_path(file);
+	if (!path) return;
+
+	int events = TraceRecorder::WriteChromeTrace(path, traceSeconds);
+	if (events < 0) {
+		obs_log(LOG_WARNING, "could not write trace to %s", path);
+	} else {
+		obs_log(LOG_INFO, "wrote %d trace events (last %.0f s) to %s", events, traceSeconds, path);
+	}
+	bfree(path);
+}
+
 bool obs_module_load(void)
 {
 	obs_frontend_add_dock_by_id(
@@ -33,11 +64,22 @@ bool obs_module_load(void)
 		new SourceResizerDock()
 	);
 
+	// Tracing is off until enabled here; unchecking writes what was recorded
+	QAction *recordTrace =
+		static_cast<QAction *>(obs_frontend_add_tools_menu_qaction("Record Source Resizer Trace"));
+	recordTrace->setCheckable(true);
+	QObject::connect(recordTrace, &QAction::toggled, [](bool on) {
+		if (!on) save_trace(nullptr);
+		TraceRecorder::SetEnabled(on);
+	});
+	obs_frontend_add_tools_menu_item("Save Source Resizer Trace", save_trace, nullptr);
+
 	obs_log(LOG_INFO, "plugin loaded successfully (version %s)", PLUGIN_VERSION);
 	return true;
 }
 
 void obs_module_unload(void)
 {
+	PerfStats::LogSummary();
 	obs_log(LOG_INFO, "plugin unloaded");
 }
@@ -0,0 +1,76 @@
+#include "rect-transform-batch-avx2.hpp"
+
+// Compiled with -mavx2 / /arch:AVX2 on x86 (see CMakeLists.txt); elsewhere
+// the kernels are empty and RectTransformBatch never selects them
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+// Same formulas and operation order (no FMA) as RectLayout::Forward/Inverse
+
+bool RectTransformBatchAvx2::Compiled()
+{
+    return true;
+}
+
+size_t RectTransformBatchAvx2::Forward(const float *parent, const float *aMin, const float *aMax, const float *pivot,
+                                       const float *pos, const float *delta, size_t n, float *outMin,
+                                       float *outSize, float *outPivot)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 p = _mm256_loadu_ps(parent + i);
+        __m256 pv = _mm256_loadu_ps(pivot + i);
+        __m256 a0 = _mm256_mul_ps(p, _mm256_loadu_ps(aMin + i));
+        __m256 span = _mm256_sub_ps(_mm256_mul_ps(p, _mm256_loadu_ps(aMax + i)), a0);
+        __m256 size = _mm256_max_ps(_mm256_add_ps(span, _mm256_loadu_ps(delta + i)), one);
+        __m256 anchorPivot = _mm256_add_ps(a0, _mm256_mul_ps(span, pv));
+        __m256 sizePivot = _mm256_mul_ps(size, pv);
+        __m256 min = _mm256_sub_ps(_mm256_add_ps(anchorPivot, _mm256_loadu_ps(pos + i)), sizePivot);
+        _mm256_storeu_ps(outMin + i, min);
+        _mm256_storeu_ps(outSize + i, size);
+        if (outPivot) _mm256_storeu_ps(outPivot + i, _mm256_add_ps(min, sizePivot));
+    }
+    return i;
+}
+
+size_t RectTransformBatchAvx2::Inverse(const float *parent, const float *aMin, const float *aMax, const float *pivot,
+                                       const float *pivotWorld, const float *size, size_t n, float *pos,
+                                       float *delta)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 p = _mm256_loadu_ps(parent + i);
+        __m256 pv = _mm256_loadu_ps(pivot + i);
+        __m256 s = _mm256_loadu_ps(size + i);
+        __m256 a0 = _mm256_mul_ps(p, _mm256_loadu_ps(aMin + i));
+        __m256 span = _mm256_sub_ps(_mm256_mul_ps(p, _mm256_loadu_ps(aMax + i)), a0);
+        __m256 sizePivot = _mm256_mul_ps(s, pv);
+        __m256 rectMin = _mm256_sub_ps(_mm256_loadu_ps(pivotWorld + i), sizePivot);
+        __m256 anchorPivot = _mm256_add_ps(a0, _mm256_mul_ps(span, pv));
+        _mm256_storeu_ps(delta + i, _mm256_sub_ps(s, span));
+        _mm256_storeu_ps(pos + i, _mm256_add_ps(_mm256_sub_ps(rectMin, anchorPivot), sizePivot));
+    }
+    return i;
+}
+
+#else
+
+bool RectTransformBatchAvx2::Compiled()
+{
+    return false;
+}
+
+size_t RectTransformBatchAvx2::Forward(const float *, const float *, const float *, const float *, const float *,
+                                       const float *, size_t, float *, float *, float *)
+{
+    return 0;
+}
+
+size_t RectTransformBatchAvx2::Inverse(const float *, const float *, const float *, const float *, const float *,
+                                       const float *, size_t, float *, float *)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * AVX2 kernels of RectTransformBatch
+ *
+ * Built in their own translation unit with AVX2 code generation and only
+ * called after RectTransformBatch checked the CPU at runtime. Plain
+ * pointers only: any inline function shared with other translation units
+ * could otherwise be emitted here with AVX2 instructions and picked by the
+ * linker for everyone.
+ *
+ * Each kernel handles the largest multiple of 8 items and returns that
+ * count; the caller finishes the tail.
+ */
+namespace RectTransformBatchAvx2 {
+
+/** False if this file was built without AVX2 (then the kernels do nothing) */
+bool Compiled();
+
+size_t Forward(const float *parent, const float *aMin, const float *aMax, const float *pivot, const float *pos,
+               const float *delta, size_t n, float *outMin, float *outSize, float *outPivot);
+
+size_t Inverse(const float *parent, const float *aMin, const float *aMax, const float *pivot,
+               const float *pivotWorld, const float *size, size_t n, float *pos, float *delta);
+
+} // namespace RectTransformBatchAvx2
@@ -0,0 +1,229 @@
+#include "rect-transform-batch.hpp"
+#include <initializer_list>
+#include "rect-transform-batch-avx2.hpp"
+
+// SSE2 is part of every x86-64 target; AVX2 lives in its own translation
+// unit and is only used when the CPU has it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RT_BATCH_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+static bool CpuHasAvx2()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // AVX plus OS support for the YMM state, then the AVX2 feature bit
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("avx2"); // Includes the OS (XGETBV) check
+#else
+    return false;
+#endif
+}
+
+static RectTransformBatch::Kernel &ActiveKernel()
+{
+    static RectTransformBatch::Kernel kernel = RectTransformBatch::BestKernel();
+    return kernel;
+}
+
+RectTransformBatch::Kernel RectTransformBatch::BestKernel()
+{
+    static const Kernel best = [] {
+        if (RectTransformBatchAvx2::Compiled() && CpuHasAvx2()) return Kernel::AVX2;
+#if defined(RT_BATCH_SSE2)
+        return Kernel::SSE2;
+#else
+        return Kernel::Scalar;
+#endif
+    }();
+    return best;
+}
+
+RectTransformBatch::Kernel RectTransformBatch::GetKernel()
+{
+    return ActiveKernel();
+}
+
+bool RectTransformBatch::SetKernel(Kernel kernel)
+{
+    if (kernel > BestKernel()) return false;
+    ActiveKernel() = kernel;
+    return true;
+}
+
+const char *RectTransformBatch::KernelName(Kernel kernel)
+{
+    switch (kernel) {
+        case Kernel::AVX2: return "AVX2";
+        case Kernel::SSE2: return "SSE2";
+        case Kernel::Scalar: break;
+    }
+    return "scalar";
+}
+
+void RectTransformBatch::Clear()
+{
+    for (Axis *a : {&x, &y}) {
+        a->parent.clear();
+        a->anchorMin.clear();
+        a->anchorMax.clear();
+        a->pivot.clear();
+        a->anchoredPos.clear();
+        a->sizeDelta.clear();
+    }
+}
+
+void RectTransformBatch::Reserve(size_t n)
+{
+    for (Axis *a : {&x, &y}) {
+        a->parent.reserve(n);
+        a->anchorMin.reserve(n);
+        a->anchorMax.reserve(n);
+        a->pivot.reserve(n);
+        a->anchoredPos.reserve(n);
+        a->sizeDelta.reserve(n);
+    }
+}
+
+size_t RectTransformBatch::Add(const RectTransform &rt, uint32_t parentW, uint32_t parentH)
+{
+    x.parent.push_back((float)parentW);
+    x.anchorMin.push_back(rt.anchorMinX);
+    x.anchorMax.push_back(rt.anchorMaxX);
+    x.pivot.push_back(rt.pivotX);
+    x.anchoredPos.push_back(rt.anchoredPosX);
+    x.sizeDelta.push_back(rt.sizeDeltaX);
+
+    y.parent.push_back((float)parentH);
+    y.anchorMin.push_back(rt.anchorMinY);
+    y.anchorMax.push_back(rt.anchorMaxY);
+    y.pivot.push_back(rt.pivotY);
+    y.anchoredPos.push_back(rt.anchoredPosY);
+    y.sizeDelta.push_back(rt.sizeDeltaY);
+
+    return Size() - 1;
+}
+
+RectTransform RectTransformBatch::Get(size_t i) const
+{
+    RectTransform rt;
+    rt.anchorMinX = x.anchorMin[i];
+    rt.anchorMaxX = x.anchorMax[i];
+    rt.pivotX = x.pivot[i];
+    rt.anchoredPosX = x.anchoredPos[i];
+    rt.sizeDeltaX = x.sizeDelta[i];
+
+    rt.anchorMinY = y.anchorMin[i];
+    rt.anchorMaxY = y.anchorMax[i];
+    rt.pivotY = y.pivot[i];
+    rt.anchoredPosY = y.anchoredPos[i];
+    rt.sizeDeltaY = y.sizeDelta[i];
+    return rt;
+}
+
+void RectTransformBatch::CalculateFinalRects(float *outX, float *outY, float *outW, float *outH, float *outPivotX,
+                                             float *outPivotY) const
+{
+    size_t n = Size();
+    ForwardAxis(x, n, outX, outW, outPivotX);
+    ForwardAxis(y, n, outY, outH, outPivotY);
+}
+
+void RectTransformBatch::SolveOffsets(const float *pivotX, const float *pivotY, const float *w, const float *h)
+{
+    size_t n = Size();
+    InverseAxis(x, n, pivotX, w);
+    InverseAxis(y, n, pivotY, h);
+}
+
+// The vector paths spell out the RectLayout formulas in the same operation
+// order (no FMA), so they produce the same floats as the scalar path. AVX2
+// covers multiples of 8 items, SSE2 what is left in steps of 4.
+
+void RectTransformBatch::ForwardAxis(const Axis &a, size_t n, float *outMin, float *outSize, float *outPivot)
+{
+    const float *parent = a.parent.data();
+    const float *aMin = a.anchorMin.data();
+    const float *aMax = a.anchorMax.data();
+    const float *pivot = a.pivot.data();
+    const float *pos = a.anchoredPos.data();
+    const float *delta = a.sizeDelta.data();
+    size_t i = 0;
+
+    Kernel kernel = ActiveKernel();
+    if (kernel == Kernel::AVX2) {
+        i = RectTransformBatchAvx2::Forward(parent, aMin, aMax, pivot, pos, delta, n, outMin, outSize, outPivot);
+    }
+
+#if defined(RT_BATCH_SSE2)
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; kernel != Kernel::Scalar && i + 4 <= n; i += 4) {
+        __m128 p = _mm_loadu_ps(parent + i);
+        __m128 pv = _mm_loadu_ps(pivot + i);
+        __m128 a0 = _mm_mul_ps(p, _mm_loadu_ps(aMin + i));
+        __m128 span = _mm_sub_ps(_mm_mul_ps(p, _mm_loadu_ps(aMax + i)), a0);
+        __m128 size = _mm_max_ps(_mm_add_ps(span, _mm_loadu_ps(delta + i)), one);
+        __m128 anchorPivot = _mm_add_ps(a0, _mm_mul_ps(span, pv));
+        __m128 sizePivot = _mm_mul_ps(size, pv);
+        __m128 min = _mm_sub_ps(_mm_add_ps(anchorPivot, _mm_loadu_ps(pos + i)), sizePivot);
+        _mm_storeu_ps(outMin + i, min);
+        _mm_storeu_ps(outSize + i, size);
+        if (outPivot) _mm_storeu_ps(outPivot + i, _mm_add_ps(min, sizePivot));
+    }
+#endif
+
+    for (; i < n; i++) {
+        RectLayout::Forward(parent[i], aMin[i], aMax[i], pivot[i], pos[i], delta[i], outMin[i], outSize[i]);
+        if (outPivot) outPivot[i] = outMin[i] + outSize[i] * pivot[i];
+    }
+}
+
+void RectTransformBatch::InverseAxis(Axis &a, size_t n, const float *pivotWorld, const float *size)
+{
+    const float *parent = a.parent.data();
+    const float *aMin = a.anchorMin.data();
+    const float *aMax = a.anchorMax.data();
+    const float *pivot = a.pivot.data();
+    float *pos = a.anchoredPos.data();
+    float *delta = a.sizeDelta.data();
+    size_t i = 0;
+
+    Kernel kernel = ActiveKernel();
+    if (kernel == Kernel::AVX2) {
+        i = RectTransformBatchAvx2::Inverse(parent, aMin, aMax, pivot, pivotWorld, size, n, pos, delta);
+    }
+
+#if defined(RT_BATCH_SSE2)
+    for (; kernel != Kernel::Scalar && i + 4 <= n; i += 4) {
+        __m128 p = _mm_loadu_ps(parent + i);
+        __m128 pv = _mm_loadu_ps(pivot + i);
+        __m128 s = _mm_loadu_ps(size + i);
+        __m128 a0 = _mm_mul_ps(p, _mm_loadu_ps(aMin + i));
+        __m128 span = _mm_sub_ps(_mm_mul_ps(p, _mm_loadu_ps(aMax + i)), a0);
+        __m128 sizePivot = _mm_mul_ps(s, pv);
+        __m128 rectMin = _mm_sub_ps(_mm_loadu_ps(pivotWorld + i), sizePivot);
+        __m128 anchorPivot = _mm_add_ps(a0, _mm_mul_ps(span, pv));
+        _mm_storeu_ps(delta + i, _mm_sub_ps(s, span));
+        _mm_storeu_ps(pos + i, _mm_add_ps(_mm_sub_ps(rectMin, anchorPivot), sizePivot));
+    }
+#endif
+
+    for (; i < n; i++) {
+        RectLayout::Inverse(parent[i], aMin[i], aMax[i], pivot[i], pivotWorld[i], size[i], pos[i], delta[i]);
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "rect-transform.hpp"
+
+/**
+ * Per-axis layout math (Unity-space)
+ *
+ * X and Y use the same formulas, so everything here works on one axis.
+ * RectTransform and the scalar path of RectTransformBatch both call these,
+ * which keeps the single-item and batched results identical.
+ */
+namespace RectLayout {
+
+/** Anchor rect on one axis: start and size in parent pixels */
+struct Span {
+    float min;
+    float size;
+};
+
+inline Span AnchorSpan(float parent, float anchorMin, float anchorMax)
+{
+    float a0 = parent * anchorMin;
+    return {a0, parent * anchorMax - a0};
+}
+
+/** Point of the anchor rect that anchoredPos offsets from */
+inline float AnchorPivot(const Span &span, float pivot)
+{
+    return span.min + span.size * pivot;
+}
+
+/** Final rect start and size (clamped to 1px) */
+inline void Forward(float parent, float anchorMin, float anchorMax, float pivot, float anchoredPos,
+                    float sizeDelta, float &outMin, float &outSize)
+{
+    Span span = AnchorSpan(parent, anchorMin, anchorMax);
+    outSize = std::max(1.0f, span.size + sizeDelta);
+    outMin = AnchorPivot(span, pivot) + anchoredPos - outSize * pivot;
+}
+
+/** anchoredPos and sizeDelta that place the pivot at 'pivotWorld' with 'size' */
+inline void Inverse(float parent, float anchorMin, float anchorMax, float pivot, float pivotWorld, float size,
+                    float &outAnchoredPos, float &outSizeDelta)
+{
+    Span span = AnchorSpan(parent, anchorMin, anchorMax);
+    float rectMin = pivotWorld - size * pivot;
+    outSizeDelta = size - span.size;
+    outAnchoredPos = rectMin - AnchorPivot(span, pivot) + size * pivot;
+}
+
+} // namespace RectLayout
+
+/**
+ * Structure-of-arrays RectTransform storage with vectorized layout kernels
+ *
+ * Used where many items are laid out at once (canvas resizes, group
+ * re-layout). Each axis keeps its fields in separate contiguous arrays, so
+ * the forward (final rect, pivot world point) and inverse (offsets from
+ * the live OBS rect) passes run over 8 (AVX2) or 4 (SSE2) items per
+ * instruction, with a scalar path for the tail and for other targets.
+ * SSE2 is the x86-64 baseline; the AVX2 kernels are built separately
+ * (rect-transform-batch-avx2.cpp) and selected at runtime from CPUID.
+ */
+class RectTransformBatch {
+public:
+    /** Vector kernels, slowest first */
+    enum class Kernel { Scalar, SSE2, AVX2 };
+
+    /** Fastest kernel this build and CPU support (the default) */
+    static Kernel BestKernel();
+
+    /**
+     * Kernel used by every batch. SetKernel picks a slower one (tests,
+     * benchmarks); returns false if 'kernel' is not supported here.
+     * Not synchronized: set it before batches run.
+     */
+    static Kernel GetKernel();
+    static bool SetKernel(Kernel kernel);
+    static const char *KernelName(Kernel kernel);
+
+    struct Axis {
+        std::vector<float> parent;
+        std::vector<float> anchorMin;
+        std::vector<float> anchorMax;
+        std::vector<float> pivot;
+        std::vector<float> anchoredPos;
+        std::vector<float> sizeDelta;
+    };
+
+    Axis x;
+    Axis y;
+
+    void Clear();
+    void Reserve(size_t n);
+    size_t Size() const { return x.parent.size(); }
+
+    /** Append one item; returns its index */
+    size_t Add(const RectTransform &rt, uint32_t parentW, uint32_t parentH);
+
+    RectTransform Get(size_t i) const;
+
+    /**
+     * Final rects (Unity-space min corner + size) for every item;
+     * outPivotX/Y (optional) receive the pivot world points
+     */
+    void CalculateFinalRects(float *outX, float *outY, float *outW, float *outH, float *outPivotX = nullptr,
+                             float *outPivotY = nullptr) const;
+
+    /** Set anchoredPos/sizeDelta from pivot world points and sizes (Unity-space) */
+    void SolveOffsets(const float *pivotX, const float *pivotY, const float *w, const float *h);
+
+private:
+    static void ForwardAxis(const Axis &a, size_t n, float *outMin, float *outSize, float *outPivot);
+    static void InverseAxis(Axis &a, size_t n, const float *pivotWorld, const float *size);
+};
@@ -0,0 +1,109 @@
+#include "rect-transform-cache.hpp"
+#include <cmath>
+#include "transform-queue.hpp"
+
+RectTransformCache::Snapshot RectTransformCache::Snapshot::Read(obs_sceneitem_t *item)
+{
+    Snapshot s;
+    obs_sceneitem_get_pos(item, &s.pos);
+    obs_sceneitem_get_bounds(item, &s.bounds);
+    s.alignment = obs_sceneitem_get_alignment(item);
+    s.boundsType = obs_sceneitem_get_bounds_type(item);
+    return s;
+}
+
+RectTransformCache::Snapshot RectTransformCache::Snapshot::Expected(const RectTransform &rt,
+                                                                   uint32_t parentW, uint32_t parentH)
+{
+    Snapshot s;
+    rt.CalculateObsTransform((float)parentW, (float)parentH, s.alignment, s.pos, s.bounds);
+    s.boundsType = OBS_BOUNDS_STRETCH;
+    return s;
+}
+
+bool RectTransformCache::Snapshot::Matches(const Snapshot &o) const
+{
+    // Same tolerance ApplyToSceneItem uses to skip setters
+    float eps = RectTransform::applyEpsilon;
+    return std::fabs(pos.x - o.pos.x) <= eps && std::fabs(pos.y - o.pos.y) <= eps &&
+           std::fabs(bounds.x - o.bounds.x) <= eps && std::fabs(bounds.y - o.bounds.y) <= eps &&
+           alignment == o.alignment && boundsType == o.boundsType;
+}
+
+RectTransform RectTransformCache::Load(obs_sceneitem_t *item, uint32_t parentW, uint32_t parentH)
+{
+    auto it = entries.find(item);
+    if (it != entries.end()) {
+        const Entry &e = it->second;
+        if (e.generation == e.itemGeneration && e.parentW == parentW && e.parentH == parentH) {
+            stats.hits++;
+            return e.rt;
+        }
+    }
+
+    stats.misses++;
+    RectTransform rt = RectTransform::LoadFromItem(item, parentW, parentH);
+    Store(item, rt, parentW, parentH);
+    return rt;
+}
+
+void RectTransformCache::Store(obs_sceneitem_t *item, const RectTransform &rt, uint32_t parentW, uint32_t parentH)
+{
+    if (!item) return;
+
+    Entry &e = entries[item];
+    e.rt = rt;
+    e.applied = Snapshot::Read(item);
+    e.parentW = parentW;
+    e.parentH = parentH;
+    e.generation = e.itemGeneration;
+    e.ticket = 0;
+}
+
+void RectTransformCache::StoreExpected(obs_sceneitem_t *item, const RectTransform &rt, uint32_t parentW,
+                                       uint32_t parentH, uint64_t ticket)
+{
+    if (!item) return;
+
+    Entry &e = entries[item];
+    e.rt = rt;
+    e.applied = Snapshot::Expected(rt, parentW, parentH);
+    e.parentW = parentW;
+    e.parentH = parentH;
+    e.generation = e.itemGeneration;
+    e.ticket = ticket;
+}
+
+void RectTransformCache::NoteTransform(obs_sceneitem_t *item)
+{
+    auto it = entries.find(item);
+    if (it == entries.end()) return;
+
+    // Our own setters end up here too; they leave the snapshot matching
+    Entry &e = it->second;
+    if (e.generation != e.itemGeneration) return;
+    if (e.ticket && queue && !queue->Applied(e.ticket)) return;
+    if (Snapshot::Read(item).Matches(e.applied)) return;
+
+    e.itemGeneration++;
+    stats.invalidations++;
+}
+
+void RectTransformCache::Invalidate(obs_sceneitem_t *item)
+{
+    auto it = entries.find(item);
+    if (it == entries.end()) return;
+
+    Entry &e = it->second;
+    if (e.generation == e.itemGeneration) stats.invalidations++;
+    e.itemGeneration = e.generation + 1;
+}
+
+void RectTransformCache::InvalidateAll()
+{
+    for (auto &entry : entries) {
+        Entry &e = entry.second;
+        if (e.generation == e.itemGeneration) stats.invalidations++;
+        e.itemGeneration = e.generation + 1;
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <obs.h>
+#include <cstdint>
+#include <unordered_map>
+#include "rect-transform.hpp"
+
+class TransformQueue;
+
+/**
+ * Per-item cache of authoritative RectTransform state
+ *
+ * LoadFromItem reverse-engineers anchoredPos/sizeDelta from the live OBS
+ * transform and reads the private settings on every call; float error
+ * then accumulates over load/apply cycles. The cache keeps the state the
+ * plugin last loaded or applied and only falls back to LoadFromItem when
+ * the item's generation moved on:
+ * - an item_transform that the plugin did not cause (live OBS state no
+ *   longer matches what was applied)
+ * - a size change of the item's parent (canvas or group)
+ *
+ * While commands for an item are still queued for the tick thread, the
+ * item_transform signals of the older ones are expected and ignored; the
+ * snapshot is compared once the last command landed.
+ *
+ * UI thread only. Items must be kept alive by the caller (the scene graph
+ * mirror holds references), and Prune() must run after mirror rebuilds.
+ */
+class RectTransformCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t invalidations = 0;
+    };
+
+    /** Cached state, or LoadFromItem on a miss */
+    RectTransform Load(obs_sceneitem_t *item, uint32_t parentW, uint32_t parentH);
+
+    /** Record state the plugin just applied to 'item' */
+    void Store(obs_sceneitem_t *item, const RectTransform &rt, uint32_t parentW, uint32_t parentH);
+
+    /** Record state that the queue will apply later (ticket from TransformQueue::Push) */
+    void StoreExpected(obs_sceneitem_t *item, const RectTransform &rt, uint32_t parentW, uint32_t parentH,
+                       uint64_t ticket);
+
+    /** Queue whose tickets StoreExpected records (nullptr before it is destroyed) */
+    void SetQueue(const TransformQueue *q) { queue = q; }
+
+    /** item_transform seen; bumps the generation if the plugin didn't cause it */
+    void NoteTransform(obs_sceneitem_t *item);
+
+    /** Parent size changed (or anything else that makes the entry unusable) */
+    void Invalidate(obs_sceneitem_t *item);
+    void InvalidateAll();
+
+    /** Drop entries for which keep(item) returns false */
+    template<typename Keep> void Prune(Keep &&keep)
+    {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (keep(it->first)) ++it;
+            else it = entries.erase(it);
+        }
+    }
+
+    void Clear() { entries.clear(); }
+
+    const Stats &GetStats() const { return stats; }
+    size_t Size() const { return entries.size(); }
+
+private:
+    // The OBS-level transform the cached state corresponds to
+    struct Snapshot {
+        vec2 pos;
+        vec2 bounds;
+        uint32_t alignment;
+        enum obs_bounds_type boundsType;
+
+        static Snapshot Read(obs_sceneitem_t *item);
+        static Snapshot Expected(const RectTransform &rt, uint32_t parentW, uint32_t parentH);
+        bool Matches(const Snapshot &o) const;
+    };
+
+    struct Entry {
+        RectTransform rt;
+        Snapshot applied;
+        uint32_t parentW = 0;
+        uint32_t parentH = 0;
+        uint32_t generation = 0;    // Generation the state was recorded at
+        uint32_t itemGeneration = 0; // Current generation of the item
+        uint64_t ticket = 0;         // Last queued command for the item (0 = none)
+    };
+
+    std::unordered_map<obs_sceneitem_t*, Entry> entries;
+    const TransformQueue *queue = nullptr;
+    Stats stats;
+};
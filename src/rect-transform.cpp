@@ -1,6 +1,38 @@
 #include "rect-transform.hpp"
 #include <cmath>
+#include <cstring>
+#include <string>
 #include <algorithm>
+#include <atomic>
+#include "pending-saves.hpp"
+#include "perf-stats.hpp"
+#include "trace-recorder.hpp"
+#include "rect-transform-batch.hpp"
+
+float RectTransform::applyEpsilon = 0.001f;
+
+// Applies run on the UI and the tick thread
+static std::atomic<uint64_t> appliesTotal{0};
+static std::atomic<uint64_t> appliesUnchanged{0};
+static std::atomic<uint64_t> settersCalled{0};
+
+static inline bool Changed(float a, float b)
+{
+    return std::fabs(a - b) > RectTransform::applyEpsilon;
+}
+
+// OBS alignment of the 3x3 quantized pivot, indexed [y][x] (Unity-space: y=0 bottom)
+static constexpr uint32_t pivotAlignment[3][3] = {
+    {OBS_ALIGN_BOTTOM | OBS_ALIGN_LEFT, OBS_ALIGN_BOTTOM, OBS_ALIGN_BOTTOM | OBS_ALIGN_RIGHT},
+    {OBS_ALIGN_LEFT, OBS_ALIGN_CENTER, OBS_ALIGN_RIGHT},
+    {OBS_ALIGN_TOP | OBS_ALIGN_LEFT, OBS_ALIGN_TOP, OBS_ALIGN_TOP | OBS_ALIGN_RIGHT},
+};
+
+// 0 below 0.25, 2 above 0.75, else 1
+static inline int PivotCell(float pivot)
+{
+    return (pivot >= 0.25f ? 1 : 0) + (pivot > 0.75f ? 1 : 0);
+}
 
 // ===== Core Calculations =====
 
@@ -8,31 +40,10 @@ void RectTransform::CalculateFinalRect(float parentW, float parentH,
                                        float& outX, float& outY,
                                        float& outW, float& outH) const
 {
-    // 1. Anchor rect in pixels (Unity-space, bottom-origin)
-    float ax0 = parentW * anchorMinX;
-    float ay0 = parentH * anchorMinY;
-    float ax1 = parentW * anchorMaxX;
-    float ay1 = parentH * anchorMaxY;
-    float anchorRectW = ax1 - ax0;
-    float anchorRectH = ay1 - ay0;
-    
-    // 2. Final size = anchor rect size + sizeDelta
-    outW = anchorRectW + sizeDeltaX;
-    outH = anchorRectH + sizeDeltaY;
-    
-    // Clamp to minimum size
-    outW = std::max(1.0f, outW);
-    outH = std::max(1.0f, outH);
-    
-    // 3. Anchor pivot point (reference point in parent space)
-    //    This is where anchoredPosition offsets from
-    float anchorPivotX = ax0 + anchorRectW * pivotX;
-    float anchorPivotY = ay0 + anchorRectH * pivotY;
-    
-    // 4. Final position (rect min corner, Unity-space)
-    //    pos = anchorPivot + anchoredPos - (size * pivot)
-    outX = anchorPivotX + anchoredPosX - (outW * pivotX);
-    outY = anchorPivotY + anchoredPosY - (outH * pivotY);
+    // Anchor rect + sizeDelta (clamped to 1px), then offset from the
+    // anchor pivot: pos = anchorPivot + anchoredPos - (size * pivot)
+    RectLayout::Forward(parentW, anchorMinX, anchorMaxX, pivotX, anchoredPosX, sizeDeltaX, outX, outW);
+    RectLayout::Forward(parentH, anchorMinY, anchorMaxY, pivotY, anchoredPosY, sizeDeltaY, outY, outH);
 }
 
 void RectTransform::GetPivotWorld(float parentW, float parentH,
@@ -47,104 +58,430 @@ void RectTransform::GetPivotWorld(float parentW, float parentH,
 
 float RectTransform::GetWidth(float parentW) const
 {
-    float anchorRectW = parentW * (anchorMaxX - anchorMinX);
-    return std::max(1.0f, anchorRectW + sizeDeltaX);
+    return std::max(1.0f, RectLayout::AnchorSpan(parentW, anchorMinX, anchorMaxX).size + sizeDeltaX);
 }
 
 float RectTransform::GetHeight(float parentH) const
 {
-    float anchorRectH = parentH * (anchorMaxY - anchorMinY);
-    return std::max(1.0f, anchorRectH + sizeDeltaY);
+    return std::max(1.0f, RectLayout::AnchorSpan(parentH, anchorMinY, anchorMaxY).size + sizeDeltaY);
+}
+
+// ===== Anchor Presets =====
+
+void RectTransform::ApplyPreset(const AnchorPreset& preset, bool shift, bool alt,
+                                float parentW, float parentH)
+{
+    if (!shift && !alt) {
+        // === Normal click: Change anchor, preserve world rect position ===
+        float oldX, oldY, oldW, oldH;
+        CalculateFinalRect(parentW, parentH, oldX, oldY, oldW, oldH);
+        float oldPivotWorldX = oldX + oldW * pivotX;
+        float oldPivotWorldY = oldY + oldH * pivotY;
+        
+        // Apply new anchors
+        anchorMinX = preset.minX;
+        anchorMinY = preset.minY;
+        anchorMaxX = preset.maxX;
+        anchorMaxY = preset.maxY;
+        
+        // Recalculate sizeDelta and anchoredPosition against the new
+        // anchor rect to keep the old size and pivot world position
+        RectLayout::Inverse(parentW, anchorMinX, anchorMaxX, pivotX, oldPivotWorldX, oldW,
+                            anchoredPosX, sizeDeltaX);
+        RectLayout::Inverse(parentH, anchorMinY, anchorMaxY, pivotY, oldPivotWorldY, oldH,
+                            anchoredPosY, sizeDeltaY);
+    }
+    else if (shift && !alt) {
+        // === Shift: Change anchor + move to anchor position ===
+        anchorMinX = preset.minX;
+        anchorMinY = preset.minY;
+        anchorMaxX = preset.maxX;
+        anchorMaxY = preset.maxY;
+        
+        // Reset offset (snap to anchor)
+        anchoredPosX = 0.0f;
+        anchoredPosY = 0.0f;
+    }
+    else if (shift && alt) {
+        // === Shift+Alt: Full preset reset (anchor + pivot + pos + size) ===
+        anchorMinX = preset.minX;
+        anchorMinY = preset.minY;
+        anchorMaxX = preset.maxX;
+        anchorMaxY = preset.maxY;
+        pivotX = preset.pivotX;
+        pivotY = preset.pivotY;
+        
+        // Reset offset
+        anchoredPosX = 0.0f;
+        anchoredPosY = 0.0f;
+        
+        // Reset size: For stretch axes, sizeDelta=0 implies filling the anchor rect.
+        if (preset.minX != preset.maxX) {
+            sizeDeltaX = 0.0f;  // Horizontal stretch
+        } else {
+            // For fixed axes, reset to 'default' or keep current?
+            // Unity resets to 100x100 usually. Let's try to keep meaningful size if possible, 
+            // but "reset" implies reset. Let's use 100 if we can't determine.
+            // Or better: Reset means "match preset". 
+            // We'll set arbitrary default size 200px if it was stretched before, 
+            // or keep current size if it's already fixed? 
+            // User said "Shift+Alt ... sizeDelta value 0".
+            // If I set sizeDelta to 0 for a non-stretch anchor, size becomes 0! That's bad (invisible).
+            
+            // Let's use the current "Width" of the item as the delta.
+            float currentW = GetWidth(parentW);
+            sizeDeltaX = (currentW > 1.0f) ? currentW : 200.0f;
+        }
+        
+        if (preset.minY != preset.maxY) {
+            sizeDeltaY = 0.0f;  // Vertical stretch
+        } else {
+            float currentH = GetHeight(parentH);
+            sizeDeltaY = (currentH > 1.0f) ? currentH : 200.0f;
+        }
+    }
+    else if (alt && !shift) {
+        // === Alt only: Just move to position (legacy behavior) ===
+        anchoredPosX = 0.0f;
+        anchoredPosY = 0.0f;
+        
+        // Temporarily apply preset anchors for calculation (simulate "what if we were anchored here")
+        // BUT we don't change the actual anchors stored in 'rt'.
+        // Wait, legacy behavior sets position based on those anchors? 
+        // In Unity, Alt-click sets position BUT NOT ANCHORS. 
+        // It moves the pivot to the anchor point defined by the preset.
+        // So we calculate where that point is, and move there.
+        
+        // Target anchor pivot position (preset anchors)
+        RectLayout::Span presetSpanX = RectLayout::AnchorSpan(parentW, preset.minX, preset.maxX);
+        RectLayout::Span presetSpanY = RectLayout::AnchorSpan(parentH, preset.minY, preset.maxY);
+        float targetPivotX = RectLayout::AnchorPivot(presetSpanX, pivotX);
+        float targetPivotY = RectLayout::AnchorPivot(presetSpanY, pivotY);
+        
+        // We want to move 'currentPivotWorld' to 'targetPivot'.
+        // anchoredPos = (TargetPos - AnchorPivot) ... 
+        // If we don't change anchors, 'AnchorPivot' is based on OLD anchors.
+        // anchoredPos = targetPivot - oldAnchorPivot.
+        
+        // Wait, Unity Alt Click: "Sets position".
+        // If I Alt-click "Top Left", it moves the object to Top-Left corner.
+        // It modifies 'anchoredPosition' such that the object is visually at Top Left.
+        // It does NOT change anchors.
+        
+        RectLayout::Span oldSpanX = RectLayout::AnchorSpan(parentW, anchorMinX, anchorMaxX);
+        RectLayout::Span oldSpanY = RectLayout::AnchorSpan(parentH, anchorMinY, anchorMaxY);
+        float oldAnchorRectW = oldSpanX.size;
+        float oldAnchorRectH = oldSpanY.size;
+        
+        float oldAnchorPivotX = RectLayout::AnchorPivot(oldSpanX, pivotX);
+        float oldAnchorPivotY = RectLayout::AnchorPivot(oldSpanY, pivotY);
+        
+        // We want the object's pivot to be at targetPivotX/Y
+        // WorldPivot = OldAnchorPivot + NewAnchoredPos
+        // NewAnchoredPos = TargetPivot - OldAnchorPivot
+        
+        anchoredPosX = targetPivotX - oldAnchorPivotX;
+        anchoredPosY = targetPivotY - oldAnchorPivotY;
+        
+        // Special case: If preset is stretch, we also resize?
+        // Unity Alt-Click on Stretch Preset: Resizes to fill that dimension.
+        // So if I accept resizing...
+        if (preset.minX != preset.maxX) {
+            // Resize width to match parent width
+            // sizeDeltaX = width - anchorRectW
+            // We want width = parentW
+            // So sizeDeltaX = parentW - anchorRectW
+             sizeDeltaX = parentW - oldAnchorRectW;
+             
+             // And we also align X to 0? 
+             // If we stretch, position should center.
+             // anchoredPos for X becomes 0 if fully centered?
+             // Let's stick to standard "Fill" logic: 0 offset from anchors.
+             // But we aren't changing anchors!
+             // If anchors are center, and we stretch:
+             // Width becomes parentW. Pivot is center.
+             // Position is center.
+             // So yes, anchoredPosX = 0.
+        }
+        if (preset.minY != preset.maxY) {
+             sizeDeltaY = parentH - oldAnchorRectH;
+        }
+    }
 }
 
 // ===== OBS Integration =====
 
-void RectTransform::ApplyToSceneItem(obs_sceneitem_t* item,
-                                     uint32_t canvasW, uint32_t canvasH) const
+void RectTransform::CalculateObsTransform(float canvasW, float canvasH,
+                                          uint32_t& outAlign, vec2& outPos,
+                                          vec2& outBounds) const
 {
-    if (!item) return;
-    
     float posX, posY, w, h;
-    CalculateFinalRect((float)canvasW, (float)canvasH, posX, posY, w, h);
+    CalculateFinalRect(canvasW, canvasH, posX, posY, w, h);
     
     // Calculate pivot world point in Unity-space
     float pivotWorldX = posX + w * pivotX;
     float pivotWorldY = posY + h * pivotY;
     
-    // Unity → OBS Y flip
-    // Unity: Y=0 bottom, Y increases upward
-    // OBS: Y=0 top, Y increases downward
-    float obsPivotY = (float)canvasH - pivotWorldY;
+    // Alignment from pivot: OBS alignment determines which point of the
+    // item 'pos' refers to (Unity pivotY=0 is bottom → OBS bottom)
+    outAlign = pivotAlignment[PivotCell(pivotY)][PivotCell(pivotX)];
+    
+    // Position (pivot point in OBS coordinates, Y flipped to top-origin)
+    outPos.x = pivotWorldX;
+    outPos.y = canvasH - pivotWorldY;
+    
+    // Size via bounds (more flexible than scale)
+    outBounds.x = w;
+    outBounds.y = h;
+}
+
+bool RectTransform::ApplyToSceneItem(obs_sceneitem_t* item,
+                                     uint32_t canvasW, uint32_t canvasH,
+                                     bool save) const
+{
+    if (!item) return false;
+    PerfStats::Scope perf(PerfStats::ApplyToSceneItem);
+    TraceRecorder::Scope trace("apply to item");
+    
+    uint32_t align;
+    vec2 pos, bounds;
+    CalculateObsTransform((float)canvasW, (float)canvasH, align, pos, bounds);
+    
+    // Diff against the live item: every setter emits item_transform and
+    // marks the item dirty for the render thread, even for equal values
+    vec2 curPos, curBounds;
+    obs_sceneitem_get_pos(item, &curPos);
+    obs_sceneitem_get_bounds(item, &curBounds);
+    
+    bool setAlign = obs_sceneitem_get_alignment(item) != align;
+    bool setPos = Changed(curPos.x, pos.x) || Changed(curPos.y, pos.y);
+    bool setBoundsType = obs_sceneitem_get_bounds_type(item) != OBS_BOUNDS_STRETCH;
+    bool setBoundsAlign = obs_sceneitem_get_bounds_alignment(item) != OBS_ALIGN_CENTER;
+    bool setBounds = Changed(curBounds.x, bounds.x) || Changed(curBounds.y, bounds.y);
+    
+    bool changed = setAlign || setPos || setBoundsType || setBoundsAlign || setBounds;
+    appliesTotal.fetch_add(1, std::memory_order_relaxed);
+    if (changed) {
+        settersCalled.fetch_add((uint64_t)setAlign + setPos + setBoundsType + setBoundsAlign + setBounds,
+                                std::memory_order_relaxed);
+        obs_sceneitem_defer_update_begin(item);
+        if (setAlign) obs_sceneitem_set_alignment(item, align);
+        if (setPos) obs_sceneitem_set_pos(item, &pos);
+        if (setBoundsType) obs_sceneitem_set_bounds_type(item, OBS_BOUNDS_STRETCH);
+        if (setBoundsAlign) obs_sceneitem_set_bounds_alignment(item, OBS_ALIGN_CENTER);
+        if (setBounds) obs_sceneitem_set_bounds(item, &bounds);
+        obs_sceneitem_defer_update_end(item);
+    } else {
+        appliesUnchanged.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Persist state (written to the private settings when the collection is saved)
+    if (save && PendingSaves::Record(item, *this)) changed = true;
+    return changed;
+}
+
+RectTransform::ApplyStats RectTransform::GetApplyStats()
+{
+    ApplyStats stats;
+    stats.applies = appliesTotal.load(std::memory_order_relaxed);
+    stats.unchanged = appliesUnchanged.load(std::memory_order_relaxed);
+    stats.setters = settersCalled.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ===== Persistence =====
+// One private-settings key holding base64 of a fixed little-endian layout:
+// { uint8 version, uint8 reserved, 10 x float32 (field order below) }.
+// Items saved by older versions carry ten rt_* doubles instead; those are
+// converted the first time the item is read.
+
+static const char* stateKey = "rt_state";
+static const uint8_t stateVersion = 1;
+static const size_t stateFloats = 10;
+static const size_t stateHeader = 2;
+static const size_t stateBytes = stateHeader + stateFloats * 4;
+
+static const char* legacyKeys[stateFloats] = {
+    "rt_anchorMinX", "rt_anchorMinY", "rt_anchorMaxX", "rt_anchorMaxY", "rt_pivotX",
+    "rt_pivotY", "rt_anchoredPosX", "rt_anchoredPosY", "rt_sizeDeltaX", "rt_sizeDeltaY",
+};
+
+static void StateFields(const RectTransform& rt, float out[stateFloats])
+{
+    const float fields[stateFloats] = {
+        rt.anchorMinX, rt.anchorMinY, rt.anchorMaxX, rt.anchorMaxY, rt.pivotX,
+        rt.pivotY, rt.anchoredPosX, rt.anchoredPosY, rt.sizeDeltaX, rt.sizeDeltaY,
+    };
+    std::copy(fields, fields + stateFloats, out);
+}
+
+static void SetStateFields(RectTransform& rt, const float in[stateFloats])
+{
+    rt.anchorMinX = in[0];
+    rt.anchorMinY = in[1];
+    rt.anchorMaxX = in[2];
+    rt.anchorMaxY = in[3];
+    rt.pivotX = in[4];
+    rt.pivotY = in[5];
+    rt.anchoredPosX = in[6];
+    rt.anchoredPosY = in[7];
+    rt.sizeDeltaX = in[8];
+    rt.sizeDeltaY = in[9];
+}
+
+static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string RectTransform::EncodeState() const
+{
+    uint8_t blob[stateBytes] = {stateVersion, 0};
+    float fields[stateFloats];
+    StateFields(*this, fields);
+    for (size_t i = 0; i < stateFloats; i++) {
+        uint32_t bits;
+        std::memcpy(&bits, &fields[i], sizeof(bits));
+        for (size_t b = 0; b < 4; b++) blob[stateHeader + i * 4 + b] = (uint8_t)(bits >> (8 * b));
+    }
+    
+    // stateBytes is a multiple of 3, so no padding
+    static_assert(stateBytes % 3 == 0, "state blob must encode without padding");
+    std::string out;
+    out.reserve(stateBytes / 3 * 4);
+    for (size_t i = 0; i < stateBytes; i += 3) {
+        uint32_t v = ((uint32_t)blob[i] << 16) | ((uint32_t)blob[i + 1] << 8) | blob[i + 2];
+        out += base64Chars[(v >> 18) & 63];
+        out += base64Chars[(v >> 12) & 63];
+        out += base64Chars[(v >> 6) & 63];
+        out += base64Chars[v & 63];
+    }
+    return out;
+}
+
+// Base64 text to the raw blob; false if malformed (any version)
+static bool DecodeBlob(const char* text, uint8_t blob[stateBytes])
+{
+    if (!text || std::strlen(text) != stateBytes / 3 * 4) return false;
+    
+    for (size_t i = 0, o = 0; o < stateBytes; i += 4, o += 3) {
+        uint32_t v = 0;
+        for (size_t c = 0; c < 4; c++) {
+            const char* p = std::strchr(base64Chars, text[i + c]);
+            if (!p || !*p) return false;
+            v = (v << 6) | (uint32_t)(p - base64Chars);
+        }
+        blob[o] = (uint8_t)(v >> 16);
+        blob[o + 1] = (uint8_t)(v >> 8);
+        blob[o + 2] = (uint8_t)v;
+    }
+    return true;
+}
+
+bool RectTransform::DecodeState(const char* text, RectTransform& rt)
+{
+    uint8_t blob[stateBytes];
+    if (!DecodeBlob(text, blob) || blob[0] != stateVersion) return false;
+    
+    float fields[stateFloats];
+    for (size_t i = 0; i < stateFloats; i++) {
+        uint32_t bits = 0;
+        for (size_t b = 0; b < 4; b++) bits |= (uint32_t)blob[stateHeader + i * 4 + b] << (8 * b);
+        std::memcpy(&fields[i], &bits, sizeof(bits));
+    }
+    SetStateFields(rt, fields);
+    return true;
+}
+
+// A state written by a newer plugin version is never overwritten or erased
+static bool NewerState(obs_data_t* settings)
+{
+    if (!obs_data_has_user_value(settings, stateKey)) return false;
     
-    // Alignment from pivot (3x3 grid quantization)
-    // OBS alignment determines which point of the item 'pos' refers to
-    uint32_t align = 0;
+    uint8_t blob[stateBytes];
+    return DecodeBlob(obs_data_get_string(settings, stateKey), blob) && blob[0] > stateVersion;
+}
+
+// Reads the packed state, migrating the old rt_* keys on the way
+static bool ReadState(obs_data_t* settings, RectTransform& rt)
+{
+    if (obs_data_has_user_value(settings, stateKey)) {
+        return RectTransform::DecodeState(obs_data_get_string(settings, stateKey), rt);
+    }
+    if (!obs_data_has_user_value(settings, legacyKeys[0])) return false;
     
-    // Horizontal alignment
-    if (pivotX < 0.25f) {
-        align |= OBS_ALIGN_LEFT;
-    } else if (pivotX > 0.75f) {
-        align |= OBS_ALIGN_RIGHT;
+    float fields[stateFloats];
+    for (size_t i = 0; i < stateFloats; i++) {
+        fields[i] = (float)obs_data_get_double(settings, legacyKeys[i]);
+        obs_data_erase(settings, legacyKeys[i]);
     }
-    // else: center (no flag = center)
-    
-    // Vertical alignment (already accounting for Y flip in pivot meaning)
-    // In Unity: pivotY=0 means bottom, pivotY=1 means top
-    // In OBS: bottom alignment = item's bottom edge at pos
-    if (pivotY < 0.25f) {
-        align |= OBS_ALIGN_BOTTOM;  // Unity bottom → OBS bottom
-    } else if (pivotY > 0.75f) {
-        align |= OBS_ALIGN_TOP;     // Unity top → OBS top
+    SetStateFields(rt, fields);
+    obs_data_set_string(settings, stateKey, rt.EncodeState().c_str());
+    return true;
+}
+
+bool RectTransform::Matches(const RectTransform& o) const
+{
+    float a[stateFloats], b[stateFloats];
+    StateFields(*this, a);
+    StateFields(o, b);
+    for (size_t i = 0; i < stateFloats; i++) {
+        if (Changed(a[i], b[i])) return false;
     }
-    // else: middle (no flag = center)
+    return true;
+}
+
+bool RectTransform::LoadStored(obs_sceneitem_t* item, RectTransform& rt, bool* newer)
+{
+    if (newer) *newer = false;
+    if (!item) return false;
     
-    obs_sceneitem_set_alignment(item, align);
+    obs_data_t* settings = obs_sceneitem_get_private_settings(item);
+    if (!settings) return false;
     
-    // Position (pivot point in OBS coordinates)
-    vec2 pos;
-    pos.x = pivotWorldX;
-    pos.y = obsPivotY;
-    obs_sceneitem_set_pos(item, &pos);
+    bool stored = ReadState(settings, rt);
+    if (!stored && newer) *newer = NewerState(settings);
+    obs_data_release(settings);
+    return stored;
+}
+
+bool RectTransform::SaveToItem(obs_sceneitem_t* item) const
+{
+    if (!item) return false;
+    PerfStats::Scope perf(PerfStats::SaveToItem);
     
-    // Size via bounds (more flexible than scale)
-    obs_sceneitem_set_bounds_type(item, OBS_BOUNDS_STRETCH);
-    obs_sceneitem_set_bounds_alignment(item, OBS_ALIGN_CENTER);
+    obs_data_t* settings = obs_sceneitem_get_private_settings(item);
+    if (!settings) return false;
     
-    vec2 bounds;
-    bounds.x = w;
-    bounds.y = h;
-    obs_sceneitem_set_bounds(item, &bounds);
+    // Nothing to do if the stored state already matches
+    RectTransform stored;
+    if ((ReadState(settings, stored) && stored.Matches(*this)) || NewerState(settings)) {
+        obs_data_release(settings);
+        return false;
+    }
     
-    // Persist state
-    SaveToItem(item);
+    obs_data_set_string(settings, stateKey, EncodeState().c_str());
+    
+    obs_data_release(settings);
+    return true;
 }
 
-void RectTransform::SaveToItem(obs_sceneitem_t* item) const
+void RectTransform::ClearStored(obs_sceneitem_t* item)
 {
     if (!item) return;
     
     obs_data_t* settings = obs_sceneitem_get_private_settings(item);
     if (!settings) return;
+    if (NewerState(settings)) {
+        obs_data_release(settings);
+        return;
+    }
     
-    obs_data_set_double(settings, "rt_anchorMinX", anchorMinX);
-    obs_data_set_double(settings, "rt_anchorMinY", anchorMinY);
-    obs_data_set_double(settings, "rt_anchorMaxX", anchorMaxX);
-    obs_data_set_double(settings, "rt_anchorMaxY", anchorMaxY);
-    obs_data_set_double(settings, "rt_pivotX", pivotX);
-    obs_data_set_double(settings, "rt_pivotY", pivotY);
-    obs_data_set_double(settings, "rt_anchoredPosX", anchoredPosX);
-    obs_data_set_double(settings, "rt_anchoredPosY", anchoredPosY);
-    obs_data_set_double(settings, "rt_sizeDeltaX", sizeDeltaX);
-    obs_data_set_double(settings, "rt_sizeDeltaY", sizeDeltaY);
-    
+    obs_data_erase(settings, stateKey);
+    for (const char* key : legacyKeys) obs_data_erase(settings, key);
     obs_data_release(settings);
 }
 
-RectTransform RectTransform::LoadFromItem(obs_sceneitem_t* item,
-                                          uint32_t parentW, uint32_t parentH)
+bool RectTransform::LoadAnchors(obs_sceneitem_t* item, RectTransform& rt)
 {
-    RectTransform rt;
-    if (!item) return rt;
+    bool stored = false;
     
     // Default to Center-Middle if no settings found
     rt.anchorMinX = rt.anchorMaxX = 0.5f;
@@ -152,17 +489,30 @@ RectTransform RectTransform::LoadFromItem(obs_sceneitem_t* item,
     rt.pivotX = 0.5f;
     rt.pivotY = 0.5f;
     
+    // Not yet flushed state wins over the private settings
+    if (const RectTransform* pending = PendingSaves::Find(item)) {
+        rt.anchorMinX = pending->anchorMinX;
+        rt.anchorMinY = pending->anchorMinY;
+        rt.anchorMaxX = pending->anchorMaxX;
+        rt.anchorMaxY = pending->anchorMaxY;
+        rt.pivotX = pending->pivotX;
+        rt.pivotY = pending->pivotY;
+        return true;
+    }
+    
     obs_data_t* settings = obs_sceneitem_get_private_settings(item);
     if (settings) {
-        if (obs_data_has_user_value(settings, "rt_anchorMinX")) {
-            rt.anchorMinX = (float)obs_data_get_double(settings, "rt_anchorMinX");
-            rt.anchorMinY = (float)obs_data_get_double(settings, "rt_anchorMinY");
-            rt.anchorMaxX = (float)obs_data_get_double(settings, "rt_anchorMaxX");
-            rt.anchorMaxY = (float)obs_data_get_double(settings, "rt_anchorMaxY");
-            rt.pivotX = (float)obs_data_get_double(settings, "rt_pivotX");
-            rt.pivotY = (float)obs_data_get_double(settings, "rt_pivotY");
+        RectTransform state;
+        if (ReadState(settings, state)) {
+            stored = true;
+            rt.anchorMinX = state.anchorMinX;
+            rt.anchorMinY = state.anchorMinY;
+            rt.anchorMaxX = state.anchorMaxX;
+            rt.anchorMaxY = state.anchorMaxY;
+            rt.pivotX = state.pivotX;
+            rt.pivotY = state.pivotY;
             // We ignore stored anchoredPos/sizeDelta to support reparenting/external moves
-            // We will recalculate them below from actual OBS state
+            // Callers recalculate them from actual OBS state
         } else {
              // Fallback inference for pivot if not stored
              uint32_t align = obs_sceneitem_get_alignment(item);
@@ -178,6 +528,13 @@ RectTransform RectTransform::LoadFromItem(obs_sceneitem_t* item,
         obs_data_release(settings);
     }
     
+    return stored;
+}
+
+void RectTransform::ReadLiveRect(obs_sceneitem_t* item, uint32_t parentH,
+                                 float& outPivotWorldX, float& outPivotWorldY,
+                                 float& outW, float& outH)
+{
     // Calculate current World Rect (Unity-space) from OBS Item
     obs_source_t* source = obs_sceneitem_get_source(item);
     float itemW = 0.0f, itemH = 0.0f;
@@ -199,104 +556,32 @@ RectTransform RectTransform::LoadFromItem(obs_sceneitem_t* item,
     
     // OBS Pos is the Pivot Point in world space (OBS coords)
     // Convert to Unity Pivot World Point
-    float pivotWorldX = pos.x;
-    float pivotWorldY = (float)parentH - pos.y; // Flip Y
-    
-    // Determine Top-Left (Unity: Top-Left is minX, maxY... wait. 
-    // Unity coords: Bottom-Left is 0,0. Top-Right is W,H. 
-    // So Top-Left is x, y+h? No.
-    // Let's stick to our CalculateFinalRect logic: 
-    // outX, outY is the BOTTOM-LEFT corner of the rect (min coords).
-    
-    float rectLeft = pivotWorldX - (itemW * rt.pivotX);
-    float rectBottom = pivotWorldY - (itemH * rt.pivotY);
-    
-    // Now Reverse Engineer anchoredPos and sizeDelta
-    
-    // 1. Anchor Rect (Unity space)
-    float ax0 = (float)parentW * rt.anchorMinX;
-    float ay0 = (float)parentH * rt.anchorMinY;
-    float ax1 = (float)parentW * rt.anchorMaxX;
-    float ay1 = (float)parentH * rt.anchorMaxY;
-    float anchorRectW = ax1 - ax0;
-    float anchorRectH = ay1 - ay0;
-    
-    // 2. sizeDelta
-    rt.sizeDeltaX = itemW - anchorRectW;
-    rt.sizeDeltaY = itemH - anchorRectH;
-    
-    // 3. Anchored Position
-    // The formula for World Position (Rect Bottom-Left):
-    // outX = anchorPivotX + anchoredPosX - (outW * pivotX)
-    // anchoredPosX = outX - anchorPivotX + (outW * pivotX)
-    //
-    // Also anchorPivot is:
-    // anchorPivotX = ax0 + anchorRectW * pivotX
-    
-    float anchorPivotX = ax0 + anchorRectW * rt.pivotX;
-    float anchorPivotY = ay0 + anchorRectH * rt.pivotY;
-    
-    // We calculated rectLeft (outX) and rectBottom (outY) above
-    rt.anchoredPosX = rectLeft - anchorPivotX + (itemW * rt.pivotX);
-    rt.anchoredPosY = rectBottom - anchorPivotY + (itemH * rt.pivotY);
+    outPivotWorldX = pos.x;
+    outPivotWorldY = (float)parentH - pos.y; // Flip Y
     
-    return rt;
+    outW = itemW;
+    outH = itemH;
 }
 
-// ===== Anchor Preset =====
-
-AnchorPreset AnchorPreset::FromEnums(int hAlign, int vAlign)
+RectTransform RectTransform::LoadFromItem(obs_sceneitem_t* item,
+                                          uint32_t parentW, uint32_t parentH)
 {
-    AnchorPreset p;
-    
-    // Horizontal: 0=Left, 1=Center, 2=Right, 3=Stretch
-    switch (hAlign) {
-        case 0: // Left
-            p.minX = p.maxX = 0.0f;
-            p.pivotX = 0.0f;
-            break;
-        case 1: // Center
-            p.minX = p.maxX = 0.5f;
-            p.pivotX = 0.5f;
-            break;
-        case 2: // Right
-            p.minX = p.maxX = 1.0f;
-            p.pivotX = 1.0f;
-            break;
-        case 3: // Stretch
-            p.minX = 0.0f;
-            p.maxX = 1.0f;
-            p.pivotX = 0.5f;
-            break;
-        default:
-            p.minX = p.maxX = 0.5f;
-            p.pivotX = 0.5f;
-    }
+    RectTransform rt;
+    if (!item) return rt;
+    PerfStats::Scope perf(PerfStats::LoadFromItem);
+    TraceRecorder::Scope trace("load from item");
     
-    // Vertical: 0=Top, 1=Middle, 2=Bottom, 3=Stretch
-    // Remember: Unity-space, Y=0 is bottom, Y=1 is top
-    switch (vAlign) {
-        case 0: // Top (Unity Y=1)
-            p.minY = p.maxY = 1.0f;
-            p.pivotY = 1.0f;
-            break;
-        case 1: // Middle
-            p.minY = p.maxY = 0.5f;
-            p.pivotY = 0.5f;
-            break;
-        case 2: // Bottom (Unity Y=0)
-            p.minY = p.maxY = 0.0f;
-            p.pivotY = 0.0f;
-            break;
-        case 3: // Stretch
-            p.minY = 0.0f;
-            p.maxY = 1.0f;
-            p.pivotY = 0.5f;
-            break;
-        default:
-            p.minY = p.maxY = 0.5f;
-            p.pivotY = 0.5f;
-    }
+    LoadAnchors(item, rt);
     
-    return p;
+    float pivotWorldX, pivotWorldY, itemW, itemH;
+    ReadLiveRect(item, parentH, pivotWorldX, pivotWorldY, itemW, itemH);
+    
+    // Reverse-engineer anchoredPos and sizeDelta: the rect's min corner is
+    // pivotWorld - size * pivot, the inverse of CalculateFinalRect
+    RectLayout::Inverse((float)parentW, rt.anchorMinX, rt.anchorMaxX, rt.pivotX, pivotWorldX, itemW,
+                        rt.anchoredPosX, rt.sizeDeltaX);
+    RectLayout::Inverse((float)parentH, rt.anchorMinY, rt.anchorMaxY, rt.pivotY, pivotWorldY, itemH,
+                        rt.anchoredPosY, rt.sizeDeltaY);
+    
+    return rt;
 }
@@ -2,6 +2,9 @@
 
 #include <obs.h>
 #include <cstdint>
+#include <string>
+
+struct AnchorPreset;
 
 /**
  * Unity-style RectTransform for OBS Scene Items
@@ -53,19 +56,70 @@ struct RectTransform {
     void GetPivotWorld(float parentW, float parentH,
                       float& outPivotX, float& outPivotY) const;
     
+    /**
+     * Apply an anchor preset the way the dock's preset buttons do:
+     * - plain: new anchors, world rect kept
+     * - shift: new anchors, snapped to the anchor point
+     * - shift+alt: anchors, pivot, position and size reset to the preset
+     * - alt: anchors kept, moved (and stretched) to the preset's point
+     */
+    void ApplyPreset(const AnchorPreset& preset, bool shift, bool alt,
+                     float parentW, float parentH);
+    
     // ===== OBS Integration =====
     
+    /**
+     * Calculate the OBS-space transform (top-origin) for this RectTransform:
+     * alignment quantized from the pivot, pivot position and bounds size
+     */
+    void CalculateObsTransform(float canvasW, float canvasH,
+                               uint32_t& outAlign, vec2& outPos,
+                               vec2& outBounds) const;
+    
     /**
      * Apply this RectTransform to an OBS scene item
      * Handles Unity→OBS Y-axis flip, sets bounds + alignment + position
+     * Only setters whose value differs by more than applyEpsilon are called
+     * (batched in one deferred update). Returns false if nothing changed.
+     * The state is recorded in PendingSaves and reaches the private settings
+     * when the collection is saved; with save=false it is not recorded.
      */
-    void ApplyToSceneItem(obs_sceneitem_t* item,
-                          uint32_t canvasW, uint32_t canvasH) const;
+    bool ApplyToSceneItem(obs_sceneitem_t* item,
+                          uint32_t canvasW, uint32_t canvasH,
+                          bool save = true) const;
     
     /**
      * Save RectTransform state to scene item's private settings
+     * Stored as one packed, versioned key ("rt_state", base64 float32s)
+     * Skips the write if the stored state already matches, and never
+     * overwrites a state written by a newer plugin version
+     * Returns true if anything was written
      */
-    void SaveToItem(obs_sceneitem_t* item) const;
+    bool SaveToItem(obs_sceneitem_t* item) const;
+    
+    /**
+     * Full state as stored in the private settings (pending state ignored)
+     * Returns false if nothing is stored. A state written by a newer plugin
+     * version reads as nothing stored (anchors are inferred) and sets
+     * *newer; it is never overwritten, so a downgrade keeps it intact
+     */
+    static bool LoadStored(obs_sceneitem_t* item, RectTransform& rt, bool* newer = nullptr);
+    
+    /**
+     * Remove the stored state (private settings only; see PendingSaves::Forget)
+     * A state written by a newer plugin version is kept
+     */
+    static void ClearStored(obs_sceneitem_t* item);
+    
+    /**
+     * The packed text stored under "rt_state", and back
+     * DecodeState returns false (rt untouched) for malformed text
+     */
+    std::string EncodeState() const;
+    static bool DecodeState(const char* text, RectTransform& rt);
+    
+    /** All ten fields equal within applyEpsilon */
+    bool Matches(const RectTransform& o) const;
     
     /**
      * Load RectTransform from scene item's private settings
@@ -74,15 +128,48 @@ struct RectTransform {
     static RectTransform LoadFromItem(obs_sceneitem_t* item,
                                       uint32_t canvasW, uint32_t canvasH);
     
+    /**
+     * Read the stored anchors and pivot into 'rt' (pivot inferred from the
+     * OBS alignment if nothing is stored). Returns false if none were stored.
+     * Pending (unsaved) state counts as stored. Items saved with the old
+     * per-field rt_* keys are converted in place.
+     */
+    static bool LoadAnchors(obs_sceneitem_t* item, RectTransform& rt);
+    
+    /**
+     * Live OBS rect of the item: pivot world point (Unity-space) and size
+     */
+    static void ReadLiveRect(obs_sceneitem_t* item, uint32_t parentH,
+                             float& outPivotWorldX, float& outPivotWorldY,
+                             float& outW, float& outH);
+    
     // ===== Utility =====
     
     /** Check if this is a stretch anchor (min != max) */
     bool IsStretchX() const { return anchorMinX != anchorMaxX; }
     bool IsStretchY() const { return anchorMinY != anchorMaxY; }
     
+    /**
+     * Does the OBS transform change with the parent width/height?
+     * Y is flipped on apply, so anchors at 1 (top) are independent of it.
+     */
+    bool DependsOnWidth() const { return anchorMinX != 0.0f || anchorMaxX != 0.0f; }
+    bool DependsOnHeight() const { return anchorMinY != 1.0f || anchorMaxY != 1.0f; }
+    
     /** Get final size for given parent dimensions */
     float GetWidth(float parentW) const;
     float GetHeight(float parentH) const;
+    
+    /** Tolerance below which a field counts as unchanged when applying/saving */
+    static float applyEpsilon;
+    
+    /** OBS calls made by ApplyToSceneItem so far (all threads) */
+    struct ApplyStats {
+        uint64_t applies = 0;   // ApplyToSceneItem calls
+        uint64_t unchanged = 0; // ... that called no setter
+        uint64_t setters = 0;   // obs_sceneitem_set_* calls
+    };
+    static ApplyStats GetApplyStats();
 };
 
 // ===== Anchor Preset Helper =====
@@ -93,5 +180,46 @@ struct AnchorPreset {
     float pivotX, pivotY;
     
     /** Create preset from enum values */
-    static AnchorPreset FromEnums(int hAlign, int vAlign);
+    static constexpr AnchorPreset FromEnums(int hAlign, int vAlign);
+};
+
+/**
+ * The 16 presets as a compile-time table, indexed [vAlign][hAlign]
+ * Horizontal: 0=Left, 1=Center, 2=Right, 3=Stretch
+ * Vertical: 0=Top, 1=Middle, 2=Bottom, 3=Stretch (Unity-space: Top is Y=1)
+ */
+inline constexpr AnchorPreset anchorPresets[4][4] = {
+    { // Top: Left, Center, Right, Stretch
+        {0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f},
+        {0.5f, 1.0f, 0.5f, 1.0f, 0.5f, 1.0f},
+        {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f},
+        {0.0f, 1.0f, 1.0f, 1.0f, 0.5f, 1.0f},
+    },
+    { // Middle: Left, Center, Right, Stretch
+        {0.0f, 0.5f, 0.0f, 0.5f, 0.0f, 0.5f},
+        {0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f},
+        {1.0f, 0.5f, 1.0f, 0.5f, 1.0f, 0.5f},
+        {0.0f, 0.5f, 1.0f, 0.5f, 0.5f, 0.5f},
+    },
+    { // Bottom: Left, Center, Right, Stretch
+        {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+        {0.5f, 0.0f, 0.5f, 0.0f, 0.5f, 0.0f},
+        {1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f, 0.5f, 0.0f},
+    },
+    { // Stretch: Left, Center, Right, Stretch
+        {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.5f},
+        {0.5f, 0.0f, 0.5f, 1.0f, 0.5f, 0.5f},
+        {1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.5f},
+        {0.0f, 0.0f, 1.0f, 1.0f, 0.5f, 0.5f},
+    },
 };
+
+constexpr AnchorPreset AnchorPreset::FromEnums(int hAlign, int vAlign)
+{
+    // Out-of-range values fall back to Center / Middle
+    return anchorPresets[(vAlign >= 0 && vAlign < 4) ? vAlign : 1][(hAlign >= 0 && hAlign < 4) ? hAlign : 1];
+}
+
+static_assert(AnchorPreset::FromEnums(3, 0).maxX == 1.0f && AnchorPreset::FromEnums(3, 0).minY == 1.0f,
+              "preset table is [vAlign][hAlign]");
@@ -0,0 +1,168 @@
+#include "scene-graph-mirror.hpp"
+#include <utility>
+#include "perf-stats.hpp"
+#include "trace-recorder.hpp"
+
+SceneGraphMirror::~SceneGraphMirror()
+{
+    Clear();
+}
+
+void SceneGraphMirror::Rebuild(obs_scene_t *root)
+{
+    PerfStats::Scope perf(PerfStats::MirrorWalk, 0);
+    TraceRecorder::Scope trace("scene walk");
+    auto oldNodes = std::move(nodes);
+    nodes.clear();
+    byItem.clear();
+    selected.clear();
+    treeOrder.clear();
+    containers.clear();
+
+    rootSource = root ? obs_scene_get_source(root) : nullptr;
+    if (rootSource) {
+        nodes.reserve(oldNodes.size());
+        treeOrder.reserve(oldNodes.size());
+        Walk(root, nullptr, obs_source_get_width(rootSource), obs_source_get_height(rootSource));
+    }
+    perf.SetUnits(nodes.size());
+
+    // Release old references only after the new ones were taken,
+    // so items that survived the rebuild never drop to zero
+    ReleaseAll(oldNodes);
+}
+
+void SceneGraphMirror::Clear()
+{
+    ReleaseAll(nodes);
+    nodes.clear();
+    byItem.clear();
+    selected.clear();
+    treeOrder.clear();
+    containers.clear();
+    rootSource = nullptr;
+}
+
+void SceneGraphMirror::ReleaseAll(std::unordered_map<SceneItemKey, Node, SceneItemKeyHash> &map)
+{
+    for (auto &entry : map) {
+        obs_sceneitem_release(entry.second.item);
+    }
+}
+
+void SceneGraphMirror::Walk(obs_scene_t *scene, obs_sceneitem_t *parent, uint32_t pW, uint32_t pH)
+{
+    size_t container = containers.size();
+
+    Container c;
+    c.group = parent;
+    c.w = pW;
+    c.h = pH;
+    containers.push_back(std::move(c));
+
+    SceneVisit::EnumItems(scene, [&](obs_scene_t *s, obs_sceneitem_t *item) {
+        SceneItemKey key = { s, obs_sceneitem_get_id(item) };
+        obs_sceneitem_addref(item);
+
+        Node node;
+        node.item = item;
+        node.parent = parent;
+        node.parentW = pW;
+        node.parentH = pH;
+        node.order = (uint32_t)nodes.size();
+        node.selected = obs_sceneitem_selected(item);
+        node.isGroup = obs_sceneitem_is_group(item);
+
+        Node &stored = nodes[key];
+        stored = node;
+        treeOrder.push_back(&stored);
+        byItem[item] = key;
+        if (node.selected) selected.insert(key);
+        // Index, not reference: recursion below may grow 'containers'
+        containers[container].children.push_back(key);
+
+        if (node.isGroup) {
+            obs_scene_t *gScene = obs_sceneitem_group_get_scene(item);
+            if (gScene) {
+                obs_source_t *gs = obs_sceneitem_get_source(item);
+                Walk(gScene, item, obs_source_get_width(gs), obs_source_get_height(gs));
+            }
+        }
+    });
+}
+
+void SceneGraphMirror::SyncSelection(const std::unordered_set<obs_sceneitem_t*> &items)
+{
+    std::unordered_set<SceneItemKey, SceneItemKeyHash> next;
+    next.reserve(items.size());
+    for (obs_sceneitem_t *item : items) {
+        // Items not mirrored yet arrive with the next Rebuild()
+        auto it = byItem.find(item);
+        if (it != byItem.end()) next.insert(it->second);
+    }
+
+    for (const SceneItemKey &key : selected) {
+        if (!next.count(key)) nodes[key].selected = false;
+    }
+    for (const SceneItemKey &key : next) {
+        nodes[key].selected = true;
+    }
+    selected.swap(next);
+}
+
+std::vector<SceneGraphMirror::SizeChange> SceneGraphMirror::RefreshParentSizes()
+{
+    // Containers are in walk order, so parents come before their groups
+    std::vector<SizeChange> changed;
+
+    for (Container &c : containers) {
+        obs_source_t *source = c.group ? obs_sceneitem_get_source(c.group) : rootSource;
+        if (!source) continue;
+
+        uint32_t w = obs_source_get_width(source);
+        uint32_t h = obs_source_get_height(source);
+        if (w == c.w && h == c.h) continue;
+
+        changed.push_back({c.group, c.w, c.h, w, h});
+        c.w = w;
+        c.h = h;
+        for (const SceneItemKey &key : c.children) {
+            Node &node = nodes[key];
+            node.parentW = w;
+            node.parentH = h;
+        }
+    }
+    return changed;
+}
+
+const SceneGraphMirror::Node *SceneGraphMirror::Find(const SceneItemKey &key) const
+{
+    auto it = nodes.find(key);
+    return it != nodes.end() ? &it->second : nullptr;
+}
+
+const SceneGraphMirror::Node *SceneGraphMirror::Find(obs_sceneitem_t *item) const
+{
+    auto it = byItem.find(item);
+    return it != byItem.end() ? Find(it->second) : nullptr;
+}
+
+const SceneGraphMirror::Node *SceneGraphMirror::FirstSelected() const
+{
+    if (selected.empty()) return nullptr;
+
+    // Large selections: the first selected node is near the front of the tree
+    if (selected.size() * 4 >= treeOrder.size()) {
+        for (const Node *node : treeOrder) {
+            if (node->selected) return node;
+        }
+        return nullptr;
+    }
+
+    const Node *first = nullptr;
+    for (const SceneItemKey &key : selected) {
+        const Node *node = Find(key);
+        if (node && (!first || node->order < first->order)) first = node;
+    }
+    return first;
+}
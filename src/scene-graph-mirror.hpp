@@ -0,0 +1,161 @@
+#pragma once
+
+#include <obs.h>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "scene-visit.hpp"
+
+/**
+ * Scene item identity
+ *
+ * obs_sceneitem_get_id is only unique within one scene, and group children
+ * live in the group's own scene, so the owning scene is part of the key.
+ */
+struct SceneItemKey {
+    obs_scene_t *scene = nullptr;
+    int64_t id = 0;
+
+    bool operator==(const SceneItemKey &o) const { return scene == o.scene && id == o.id; }
+};
+
+struct SceneItemKeyHash {
+    size_t operator()(const SceneItemKey &k) const
+    {
+        size_t h = std::hash<const void*>()(k.scene);
+        return h ^ (std::hash<int64_t>()(k.id) + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+};
+
+/**
+ * UI-thread mirror of the tracked scene tree
+ *
+ * Rebuilt only on structural changes (item_add/remove, reorder, refresh).
+ * Selection and cached parent sizes are patched incrementally, so handlers
+ * only touch the selected items instead of walking the whole tree under
+ * the scene mutex.
+ */
+class SceneGraphMirror {
+public:
+    struct Node {
+        obs_sceneitem_t *item = nullptr;   // Holds a reference
+        obs_sceneitem_t *parent = nullptr; // Owning group item (nullptr = root scene)
+        uint32_t parentW = 0;              // Cached parent (canvas/group) size
+        uint32_t parentH = 0;
+        uint32_t order = 0;                // Depth-first position in the tree
+        bool selected = false;
+        bool isGroup = false;
+    };
+
+    /** Size change of the canvas (group = nullptr) or of a group's contents */
+    struct SizeChange {
+        obs_sceneitem_t *group;
+        uint32_t oldW, oldH;
+        uint32_t w, h;
+    };
+
+    enum class Filter { All, Selected };
+
+    SceneGraphMirror() = default;
+    ~SceneGraphMirror();
+
+    SceneGraphMirror(const SceneGraphMirror &) = delete;
+    SceneGraphMirror &operator=(const SceneGraphMirror &) = delete;
+
+    /** Full re-walk of 'root' (structural changes only) */
+    void Rebuild(obs_scene_t *root);
+    void Clear();
+
+    /** Replace the selected set; only nodes whose flag flips are touched */
+    void SyncSelection(const std::unordered_set<obs_sceneitem_t*> &items);
+
+    /**
+     * Re-read canvas and group sizes into the children's cached parent size.
+     * Returns the containers whose size actually changed, parents first.
+     */
+    std::vector<SizeChange> RefreshParentSizes();
+
+    const Node *Find(const SceneItemKey &key) const;
+    const Node *Find(obs_sceneitem_t *item) const;
+
+    /** First selected item in tree order, or nullptr */
+    const Node *FirstSelected() const;
+
+    /*
+     * Visitors are called as visitor(item, parentW, parentH) and may return
+     * false to stop early (see SceneVisit). Nothing is allocated. All of
+     * them return false if the visitor stopped the walk.
+     */
+
+    /** Visit items in tree order, all or only the selected ones */
+    template<typename Visitor> bool ForEach(Filter filter, Visitor &&visitor) const
+    {
+        for (const Node *node : treeOrder) {
+            if (filter == Filter::Selected && !node->selected) continue;
+            if (!SceneVisit::Call(visitor, node->item, node->parentW, node->parentH)) return false;
+        }
+        return true;
+    }
+
+    /** Visit selected items (tree order not guaranteed), without scanning the tree */
+    template<typename Visitor> bool ForEachSelected(Visitor &&visitor) const
+    {
+        for (const SceneItemKey &key : selected) {
+            const Node *node = Find(key);
+            if (node && !SceneVisit::Call(visitor, node->item, node->parentW, node->parentH)) return false;
+        }
+        return true;
+    }
+
+    /** Visit the direct children of 'group' (nullptr = root scene) */
+    template<typename Visitor> bool ForEachChild(obs_sceneitem_t *group, Visitor &&visitor) const
+    {
+        for (const Container &c : containers) {
+            if (c.group != group) continue;
+            for (const SceneItemKey &key : c.children) {
+                const Node *node = Find(key);
+                if (node && !SceneVisit::Call(visitor, node->item, node->parentW, node->parentH)) return false;
+            }
+            break;
+        }
+        return true;
+    }
+
+    /** Visit the group items as visitor(group, w, h) with their last read size */
+    template<typename Visitor> bool ForEachGroup(Visitor &&visitor) const
+    {
+        for (const Container &c : containers) {
+            if (c.group && !SceneVisit::Call(visitor, c.group, c.w, c.h)) return false;
+        }
+        return true;
+    }
+
+    size_t Size() const { return nodes.size(); }
+    size_t SelectedCount() const { return selected.size(); }
+    size_t GroupCount() const { return containers.empty() ? 0 : containers.size() - 1; }
+
+private:
+    void Walk(obs_scene_t *scene, obs_sceneitem_t *parent, uint32_t pW, uint32_t pH);
+    void ReleaseAll(std::unordered_map<SceneItemKey, Node, SceneItemKeyHash> &map);
+
+    std::unordered_map<SceneItemKey, Node, SceneItemKeyHash> nodes;
+
+    // Translates signal-provided pointers; only items we hold a ref on are here
+    std::unordered_map<obs_sceneitem_t*, SceneItemKey> byItem;
+
+    std::unordered_set<SceneItemKey, SceneItemKeyHash> selected;
+
+    // Depth-first order; map nodes stay put on rehash, only Rebuild/Clear drop them
+    std::vector<const Node*> treeOrder;
+
+    // Root canvas plus one entry per group item: child keys and last size
+    struct Container {
+        obs_sceneitem_t *group = nullptr;
+        uint32_t w = 0, h = 0;
+        std::vector<SceneItemKey> children;
+    };
+    std::vector<Container> containers;
+    obs_source_t *rootSource = nullptr; // Not referenced, only used while tracked
+};
@@ -0,0 +1,92 @@
+#include "scene-subscriptions.hpp"
+#include <utility>
+#include "scene-visit.hpp"
+
+SceneSubscriptions::SceneSubscriptions(std::vector<Handler> handlers, void *data)
+    : handlers(std::move(handlers)), data(data)
+{
+}
+
+SceneSubscriptions::~SceneSubscriptions()
+{
+    Clear();
+}
+
+void SceneSubscriptions::Sync(obs_scene_t *root)
+{
+    std::unordered_set<obs_source_t*> desired;
+    std::vector<obs_source_t*> added;
+    if (root) {
+        desired.reserve(tracked.size() + 1);
+        Collect(root, desired, added);
+    }
+
+    // Drop subscriptions for scenes/groups that are gone
+    for (auto it = tracked.begin(); it != tracked.end();) {
+        if (desired.count(*it)) {
+            ++it;
+            continue;
+        }
+        Disconnect(*it);
+        obs_source_release(*it);
+        it = tracked.erase(it);
+    }
+
+    // Connect newly appeared ones (reference already taken in Collect)
+    for (obs_source_t *source : added) {
+        tracked.insert(source);
+        Connect(source);
+    }
+}
+
+void SceneSubscriptions::Clear()
+{
+    for (obs_source_t *source : tracked) {
+        Disconnect(source);
+        obs_source_release(source);
+    }
+    tracked.clear();
+}
+
+void SceneSubscriptions::Collect(obs_scene_t *scene, std::unordered_set<obs_source_t*> &desired,
+                                 std::vector<obs_source_t*> &added)
+{
+    obs_source_t *source = obs_scene_get_source(scene);
+    if (!source) return;
+
+    if (!desired.insert(source).second) return;
+
+    // Only new sources need a reference, tracked ones already hold one
+    if (!tracked.count(source)) {
+        added.push_back(obs_source_get_ref(source));
+    }
+
+    // Recurse into groups
+    SceneVisit::EnumItems(scene, [&](obs_scene_t *, obs_sceneitem_t *item) {
+        if (!obs_sceneitem_is_group(item)) return;
+        obs_scene_t *gScene = obs_sceneitem_group_get_scene(item);
+        if (gScene) Collect(gScene, desired, added);
+    });
+}
+
+void SceneSubscriptions::Connect(obs_source_t *source)
+{
+    signal_handler_t *sh = obs_source_get_signal_handler(source);
+    if (!sh) return;
+
+    for (const Handler &h : handlers) {
+        signal_handler_connect(sh, h.signal, h.callback, data);
+        connectCalls++;
+    }
+}
+
+void SceneSubscriptions::Disconnect(obs_source_t *source)
+{
+    signal_handler_t *sh = obs_source_get_signal_handler(source);
+    if (!sh) return;
+
+    for (const Handler &h : handlers) {
+        signal_handler_disconnect(sh, h.signal, h.callback, data);
+        disconnectCalls++;
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <obs.h>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Persistent signal subscriptions for a scene and all of its nested groups
+ *
+ * Connections stay alive across refreshes. Sync() walks the tree and only
+ * connects newly appeared scenes/groups and disconnects vanished ones, so
+ * a sync against an unchanged scene graph makes no signal_handler calls.
+ */
+class SceneSubscriptions {
+public:
+    struct Handler {
+        const char *signal;
+        signal_callback_t callback;
+    };
+
+    SceneSubscriptions(std::vector<Handler> handlers, void *data);
+    ~SceneSubscriptions();
+
+    SceneSubscriptions(const SceneSubscriptions &) = delete;
+    SceneSubscriptions &operator=(const SceneSubscriptions &) = delete;
+
+    /** Diff the subscription set against the tree under 'root' */
+    void Sync(obs_scene_t *root);
+
+    /** Disconnect everything and release all held sources */
+    void Clear();
+
+    size_t Size() const { return tracked.size(); }
+
+    // Instrumentation (signal_handler_connect/disconnect calls made)
+    uint64_t ConnectCalls() const { return connectCalls; }
+    uint64_t DisconnectCalls() const { return disconnectCalls; }
+
+private:
+    void Collect(obs_scene_t *scene, std::unordered_set<obs_source_t*> &desired,
+                 std::vector<obs_source_t*> &added);
+    void Connect(obs_source_t *source);
+    void Disconnect(obs_source_t *source);
+
+    std::vector<Handler> handlers;
+    void *data;
+
+    // Scene/group sources we are connected to (each holds a reference)
+    std::unordered_set<obs_source_t*> tracked;
+
+    uint64_t connectCalls = 0;
+    uint64_t disconnectCalls = 0;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <obs.h>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Allocation-free helpers for visiting scene items with any callable
+ *
+ * Callables are taken by reference and called through a template, so
+ * lambda captures are never copied into a std::function and the visitor
+ * body is inlined into the loop. A visitor may return bool (false stops
+ * the walk) or nothing (visit everything).
+ */
+namespace SceneVisit {
+
+/** Call 'visitor'; false if it asked to stop */
+template<typename Visitor, typename... Args> inline bool Call(Visitor &visitor, Args &&...args)
+{
+    if constexpr (std::is_void_v<std::invoke_result_t<Visitor &, Args...>>) {
+        visitor(std::forward<Args>(args)...);
+        return true;
+    } else {
+        return static_cast<bool>(visitor(std::forward<Args>(args)...));
+    }
+}
+
+/** obs_scene_enum_items with visitor(obs_scene_t*, obs_sceneitem_t*) */
+template<typename Visitor> inline void EnumItems(obs_scene_t *scene, Visitor &&visitor)
+{
+    using V = std::remove_reference_t<Visitor>;
+    obs_scene_enum_items(
+        scene,
+        [](obs_scene_t *s, obs_sceneitem_t *item, void *param) {
+            return Call(*reinterpret_cast<V*>(param), s, item);
+        },
+        const_cast<void*>(static_cast<const void*>(&visitor)));
+}
+
+} // namespace SceneVisit
@@ -0,0 +1,275 @@
+#include "selection-tracker.hpp"
+#include <QMetaObject>
+#include "perf-stats.hpp"
+#include "trace-recorder.hpp"
+
+// Past this many unprocessed item_transform events just drop the whole cache
+static const size_t maxPendingTransforms = 4096;
+
+SelectionTracker::SelectionTracker(QObject *parent)
+    : QObject(parent),
+      subscriptions({
+          // Signals that change which scenes/groups exist -> re-sync
+          { "item_add", OBSSceneStructureSignal },
+          { "item_remove", OBSSceneStructureSignal },
+          { "reorder", OBSSceneStructureSignal },
+          { "refresh", OBSSceneStructureSignal },
+          // Signals that only change what the dock displays
+          { "item_select", OBSSelectSignal },
+          { "item_deselect", OBSDeselectSignal },
+          { "item_transform", OBSSceneItemSignal },
+          { "item_visible", OBSSceneItemSignal },
+      }, this)
+{
+}
+
+SelectionTracker::~SelectionTracker()
+{
+    Detach();
+}
+
+void SelectionTracker::Attach(obs_scene_t *scene)
+{
+    obs_source_t *source = scene ? obs_scene_get_source(scene) : nullptr;
+    if (!source) {
+        Detach();
+        return;
+    }
+
+    if (source != rootSource) {
+        if (rootSource) obs_source_release(rootSource);
+        rootSource = obs_source_get_ref(source);
+    }
+
+    // Only scenes/groups that differ from the current set get (dis)connected
+    subscriptions.Sync(scene);
+    RebuildMirror();
+}
+
+void SelectionTracker::Detach()
+{
+    subscriptions.Clear();
+
+    if (rootSource) {
+        obs_source_release(rootSource);
+        rootSource = nullptr;
+    }
+
+    mirror.Clear();
+    transforms.Clear();
+    hasGroups.store(false);
+
+    std::lock_guard<std::mutex> lock(selectionMutex);
+    selection.clear();
+    transformed.clear();
+    transformedOverflow = false;
+}
+
+void SelectionTracker::RequestRefresh()
+{
+    MarkDirty();
+}
+
+void SelectionTracker::RequestSizeRefresh()
+{
+    // ApplyPending re-reads parent sizes whenever transforms are dirty
+    transformDirty = true;
+    MarkDirty();
+}
+
+bool SelectionTracker::IsSelected(obs_sceneitem_t *item) const
+{
+    std::lock_guard<std::mutex> lock(selectionMutex);
+    return selection.count(item) != 0;
+}
+
+const SceneGraphMirror &SelectionTracker::Mirror()
+{
+    ApplyPending();
+    return mirror;
+}
+
+void SelectionTracker::ApplyPending()
+{
+    if (selectionDirty.exchange(false)) {
+        std::unordered_set<obs_sceneitem_t*> current;
+        {
+            std::lock_guard<std::mutex> lock(selectionMutex);
+            current = selection;
+        }
+        mirror.SyncSelection(current);
+    }
+
+    if (!transformDirty.exchange(false)) return;
+
+    std::vector<obs_sceneitem_t*> items;
+    bool overflow;
+    {
+        std::lock_guard<std::mutex> lock(selectionMutex);
+        items.swap(transformed);
+        overflow = transformedOverflow;
+        transformedOverflow = false;
+    }
+
+    // External edits bump the item's cache generation (pointers are only
+    // dereferenced if the mirror still holds a reference to them)
+    if (overflow) {
+        transforms.InvalidateAll();
+    } else {
+        for (obs_sceneitem_t *item : items) {
+            if (mirror.Find(item)) transforms.NoteTransform(item);
+        }
+    }
+
+    // Canvas/group size changes invalidate the children as well
+    for (const SceneGraphMirror::SizeChange &change : mirror.RefreshParentSizes()) {
+        mirror.ForEachChild(change.group, [&](obs_sceneitem_t *child, uint32_t, uint32_t) {
+            transforms.Invalidate(child);
+        });
+        // The canvas is handled by CanvasRelayout for all scenes
+        if (change.group) emit GroupResized(change.group, change.oldW, change.oldH);
+    }
+}
+
+SelectionTracker::Stats SelectionTracker::GetStats() const
+{
+    Stats stats;
+    stats.signalsReceived = signalsReceived.load(std::memory_order_relaxed);
+    stats.signalsFiltered = signalsFiltered.load(std::memory_order_relaxed);
+    stats.refreshesCoalesced = refreshesCoalesced.load(std::memory_order_relaxed);
+    stats.refreshesRun = refreshesRun.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SelectionTracker::Resubscribe()
+{
+    resyncQueued.store(false);
+    if (!rootSource) return;
+
+    // Groups may have been added or removed, apply only the difference
+    subscriptions.Sync(obs_scene_from_source(rootSource));
+    RebuildMirror();
+
+    MarkDirty();
+}
+
+void SelectionTracker::NotifyChanged()
+{
+    TraceRecorder::Scope trace("queued refresh");
+    // Clear before emitting so signals raised by the refresh queue a new one
+    refreshQueued.store(false);
+    refreshesRun.fetch_add(1, std::memory_order_relaxed);
+
+    // Group resizes are found here even while nobody reads the mirror
+    ApplyPending();
+    emit Changed();
+}
+
+void SelectionTracker::ProcessPending()
+{
+    TraceRecorder::Scope trace("pending transforms");
+    pendingQueued.store(false);
+    ApplyPending();
+}
+
+void SelectionTracker::MarkDirty()
+{
+    if (refreshQueued.exchange(true)) {
+        refreshesCoalesced.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    QMetaObject::invokeMethod(this, "NotifyChanged", Qt::QueuedConnection);
+}
+
+void SelectionTracker::RebuildMirror()
+{
+    // One walk refreshes the mirror, the selection set is derived from it
+    mirror.Rebuild(rootSource ? obs_scene_from_source(rootSource) : nullptr);
+    selectionDirty.store(false);
+    hasGroups.store(mirror.GroupCount() != 0);
+
+    // Forget cached state of items that are gone, their pointers may be reused
+    transforms.Prune([&](obs_sceneitem_t *item) { return mirror.Find(item) != nullptr; });
+
+    std::unordered_set<obs_sceneitem_t*> current;
+    current.reserve(mirror.SelectedCount());
+    mirror.ForEachSelected([&](obs_sceneitem_t *item, uint32_t, uint32_t) {
+        current.insert(item);
+    });
+
+    std::lock_guard<std::mutex> lock(selectionMutex);
+    selection.swap(current);
+}
+
+void SelectionTracker::OBSSceneStructureSignal(void *data, calldata_t *)
+{
+    PerfStats::Scope perf(PerfStats::Signal);
+    TraceRecorder::Scope trace("structure signal");
+    SelectionTracker *tracker = reinterpret_cast<SelectionTracker*>(data);
+    if (tracker->resyncQueued.exchange(true)) return;
+    QMetaObject::invokeMethod(tracker, "Resubscribe", Qt::QueuedConnection);
+}
+
+void SelectionTracker::OBSSelectSignal(void *data, calldata_t *cd)
+{
+    PerfStats::Scope perf(PerfStats::Signal);
+    TraceRecorder::Scope trace("select signal");
+    SelectionTracker *tracker = reinterpret_cast<SelectionTracker*>(data);
+    obs_sceneitem_t *item = (obs_sceneitem_t*)calldata_ptr(cd, "item");
+    tracker->signalsReceived.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(tracker->selectionMutex);
+        tracker->selection.insert(item);
+    }
+    tracker->selectionDirty.store(true);
+    tracker->MarkDirty();
+}
+
+void SelectionTracker::OBSDeselectSignal(void *data, calldata_t *cd)
+{
+    PerfStats::Scope perf(PerfStats::Signal);
+    TraceRecorder::Scope trace("deselect signal");
+    SelectionTracker *tracker = reinterpret_cast<SelectionTracker*>(data);
+    obs_sceneitem_t *item = (obs_sceneitem_t*)calldata_ptr(cd, "item");
+    tracker->signalsReceived.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(tracker->selectionMutex);
+        tracker->selection.erase(item);
+    }
+    tracker->selectionDirty.store(true);
+    tracker->MarkDirty();
+}
+
+void SelectionTracker::OBSSceneItemSignal(void *data, calldata_t *cd)
+{
+    PerfStats::Scope perf(PerfStats::Signal);
+    TraceRecorder::Scope trace("item signal");
+    SelectionTracker *tracker = reinterpret_cast<SelectionTracker*>(data);
+    obs_sceneitem_t *item = (obs_sceneitem_t*)calldata_ptr(cd, "item");
+    tracker->signalsReceived.fetch_add(1, std::memory_order_relaxed);
+
+    // Recorded for cache invalidation (and the size of the group it lives in),
+    // whether selected or not
+    bool selected;
+    {
+        std::lock_guard<std::mutex> lock(tracker->selectionMutex);
+        if (tracker->transformed.size() < maxPendingTransforms) {
+            tracker->transformed.push_back(item);
+        } else {
+            tracker->transformedOverflow = true;
+        }
+        selected = tracker->selection.count(item) != 0;
+    }
+    tracker->transformDirty.store(true);
+
+    // Transform/visibility of unselected items never changes what the dock shows,
+    // but may change a group's size, which is picked up without a refresh
+    if (!selected) {
+        tracker->signalsFiltered.fetch_add(1, std::memory_order_relaxed);
+        if (tracker->hasGroups.load() && !tracker->pendingQueued.exchange(true)) {
+            QMetaObject::invokeMethod(tracker, "ProcessPending", Qt::QueuedConnection);
+        }
+        return;
+    }
+    tracker->MarkDirty();
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <QObject>
+#include <obs.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include "rect-transform-cache.hpp"
+#include "scene-graph-mirror.hpp"
+#include "scene-subscriptions.hpp"
+
+/**
+ * Event-driven selection tracking for the current scene
+ *
+ * Hooks the structural signals (item_add, item_remove, reorder, refresh)
+ * and the selection signals (item_select, item_deselect, ...) of the root
+ * scene and of every nested group scene. Emits Changed() on the UI thread
+ * whenever the dock needs to refresh, so no polling is required.
+ *
+ * Refreshes are coalesced: signal callbacks drop events for items outside
+ * the selection and set an atomic dirty flag, so at most one Changed() is
+ * queued per event-loop turn no matter how many signals fire.
+ *
+ * Also owns the SceneGraphMirror of the tracked tree, which is rebuilt on
+ * structural signals and patched for selection and size changes, and the
+ * RectTransformCache, which is invalidated from item_transform signals.
+ * Pending changes are applied before Changed() is emitted, so
+ * GroupResized() fires whether or not anything listens to Changed().
+ */
+class SelectionTracker : public QObject {
+    Q_OBJECT
+
+public:
+    struct Stats {
+        uint64_t signalsReceived = 0;    // Item signals seen (any thread)
+        uint64_t signalsFiltered = 0;    // Dropped, item not selected
+        uint64_t refreshesCoalesced = 0; // Merged into an already queued refresh
+        uint64_t refreshesRun = 0;       // Changed() actually emitted
+    };
+
+    explicit SelectionTracker(QObject *parent = nullptr);
+    ~SelectionTracker() override;
+
+    /** Start tracking a scene (only the difference to the old one is applied) */
+    void Attach(obs_scene_t *scene);
+
+    /** Stop tracking and release all held sources */
+    void Detach();
+
+    /** Tracked root scene, or nullptr while detached */
+    obs_scene_t *RootScene() const { return rootSource ? obs_scene_from_source(rootSource) : nullptr; }
+
+    /** Queue a coalesced Changed() (e.g. after the dock edited items) */
+    void RequestRefresh();
+
+    /** Canvas or group sizes may have changed; re-read them on the next refresh */
+    void RequestSizeRefresh();
+
+    /** Thread-safe: is 'item' part of the current selection? */
+    bool IsSelected(obs_sceneitem_t *item) const;
+
+    /** Mirror of the tracked tree (applies pending selection/size changes first) */
+    const SceneGraphMirror &Mirror();
+
+    /** RectTransform cache of mirrored items (invalidations applied by Mirror()) */
+    RectTransformCache &Transforms() { return transforms; }
+
+    const SceneSubscriptions &Subscriptions() const { return subscriptions; }
+    Stats GetStats() const;
+
+signals:
+    void Changed();
+
+    /** Contents of a tracked group changed size (children laid out for 'oldW' x 'oldH') */
+    void GroupResized(obs_sceneitem_t *group, uint32_t oldW, uint32_t oldH);
+
+private slots:
+    void Resubscribe();
+    void NotifyChanged();
+    void ProcessPending();
+
+private:
+    void RebuildMirror();
+    void ApplyPending();
+    void MarkDirty();
+
+    // Static callbacks for OBS signals (may run on any thread)
+    static void OBSSceneStructureSignal(void *data, calldata_t *cd);
+    static void OBSSelectSignal(void *data, calldata_t *cd);
+    static void OBSDeselectSignal(void *data, calldata_t *cd);
+    static void OBSSceneItemSignal(void *data, calldata_t *cd);
+
+    // Root scene source (holds a reference while attached)
+    obs_source_t *rootSource = nullptr;
+
+    // Persistent connections (Main scene + Groups)
+    SceneSubscriptions subscriptions;
+
+    // UI-thread copy of the tree, see Mirror()
+    SceneGraphMirror mirror;
+    RectTransformCache transforms;
+
+    // Selected items, readable from the signal thread for filtering,
+    // and items whose transform changed since the last ApplyPending()
+    mutable std::mutex selectionMutex;
+    std::unordered_set<obs_sceneitem_t*> selection;
+    std::vector<obs_sceneitem_t*> transformed;
+    bool transformedOverflow = false;
+
+    // Coalescing flags: set on the signal thread, cleared on the UI thread
+    std::atomic<bool> refreshQueued{false};
+    std::atomic<bool> resyncQueued{false};
+    std::atomic<bool> selectionDirty{false};
+    std::atomic<bool> transformDirty{false};
+    std::atomic<bool> pendingQueued{false};
+    std::atomic<bool> hasGroups{false}; // Unselected transforms may resize a group
+
+    std::atomic<uint64_t> signalsReceived{0};
+    std::atomic<uint64_t> signalsFiltered{0};
+    std::atomic<uint64_t> refreshesCoalesced{0};
+    std::atomic<uint64_t> refreshesRun{0};
+};
@@ -1,6 +1,7 @@
 #include "source-resizer-dock.hpp"
 #include <obs.h>
 #include <obs-frontend-api.h>
+#include <plugin-support.h>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPushButton>
@@ -8,17 +9,34 @@
 #include <QSpinBox>
 #include <QGroupBox>
 #include <QMetaObject>
-#include <QTimer>
 #include <QKeyEvent>
+#include <QShowEvent>
+#include <QHideEvent>
 #include <QApplication>
 #include <QGridLayout>
 #include <QStackedLayout>
 #include <QLineEdit>
 #include <QCheckBox>
-#include <functional>
+#include <QTimer>
+#include <QToolButton>
+#include <cstdio>
+#include <string>
 #include <utility>
 #include "anchor-button.hpp"
 #include "rect-transform.hpp"
+#include "rect-transform-batch.hpp"
+#include "selection-tracker.hpp"
+#include "edit-scheduler.hpp"
+#include "transform-queue.hpp"
+#include "bulk-scheduler.hpp"
+#include "canvas-relayout.hpp"
+#include "group-layout.hpp"
+#include "pending-saves.hpp"
+#include "dock-view-model.hpp"
+#include "edit-latency.hpp"
+#include "perf-stats.hpp"
+#include "trace-recorder.hpp"
+#include <util/platform.h>
 
 // Global callback wrapper
 static void frontend_event_callback(enum obs_frontend_event event, void *param)
@@ -27,56 +45,42 @@ static void frontend_event_callback(enum obs_frontend_event event, void *param)
     dock->HandleFrontendEvent(event);
 }
 
-// Helper for recursive enumeration of selected items
-struct EnumContext {
-    std::function<void(obs_sceneitem_t*, uint32_t, uint32_t)> callback;
-};
-
-static void EnumRecurse(obs_scene_t *scene, uint32_t pW, uint32_t pH, EnumContext *ctx) {
-    struct Params {
-        EnumContext *ctx;
-        uint32_t pW, pH;
-    } p = { ctx, pW, pH };
-
-    obs_scene_enum_items(scene, [](obs_scene_t *, obs_sceneitem_t *item, void *param) {
-        Params *pp = (Params*)param;
-        if (obs_sceneitem_selected(item)) {
-            pp->ctx->callback(item, pp->pW, pp->pH);
-        }
-        if (obs_sceneitem_is_group(item)) {
-             obs_scene_t *gScene = obs_sceneitem_group_get_scene(item);
-             if (gScene) {
-                 obs_source_t *gs = obs_sceneitem_get_source(item);
-                 uint32_t gw = obs_source_get_width(gs);
-                 uint32_t gh = obs_source_get_height(gs);
-                 EnumRecurse(gScene, gw, gh, pp->ctx);
-             }
-        }
-        return true;
-    }, &p);
+// Private settings are serialized after this returns, so flushing here
+// still lands in the file being written
+static void frontend_save_callback(obs_data_t *, bool saving, void *)
+{
+    if (saving) PendingSaves::Flush();
 }
 
-// 1. New version with Parent Dimensions
-static void EnumSelectedItemsRecursive(obs_scene_t *scene, std::function<void(obs_sceneitem_t*, uint32_t, uint32_t)> callback) {
-    if (!scene) return;
-    obs_source_t *s = obs_scene_get_source(scene);
-    uint32_t w = obs_source_get_width(s);
-    uint32_t h = obs_source_get_height(s);
-    EnumContext ctx = { callback };
-    EnumRecurse(scene, w, h, &ctx);
-}
+SourceResizerDock::SourceResizerDock(QWidget *parent) : QWidget(parent)
+{
+    // Widgets and per-frame edit work wait for the first show. Layout that
+    // follows the scene (canvas and group resizes) runs whether or not the
+    // dock is open, so it needs the scene tracked from the start.
+    canvasRelayout = new CanvasRelayout(this);
+    tracker = new SelectionTracker(this);
+    connect(canvasRelayout, &CanvasRelayout::Resized, tracker, &SelectionTracker::RequestSizeRefresh);
+    connect(tracker, &SelectionTracker::Changed, this, &SourceResizerDock::RefreshFromSelection);
+
+    groupLayout = new GroupLayout(tracker, this);
+    connect(tracker, &SelectionTracker::GroupResized, groupLayout, &GroupLayout::MarkDirty);
+    connect(groupLayout, &GroupLayout::LaidOut, tracker, &SelectionTracker::RequestRefresh);
+    AttachCurrentScene();
 
-// 2. Legacy overload for existing code
-static void EnumSelectedItemsRecursive(obs_scene_t *scene, std::function<void(obs_sceneitem_t*)> callback) {
-    EnumSelectedItemsRecursive(scene, [callback](obs_sceneitem_t *item, uint32_t, uint32_t) {
-        callback(item);
-    });
+    obs_frontend_add_event_callback(frontend_event_callback, this);
+    obs_frontend_add_save_callback(frontend_save_callback, this);
 }
 
-SourceResizerDock::SourceResizerDock(QWidget *parent) : QWidget(parent)
+void SourceResizerDock::Build()
 {
-    // Main Stack Layout
-    mainStack = new QStackedLayout(this);
+    TraceRecorder::NameThread("ui");
+
+    // Main Stack Layout, diagnostics below it
+    QVBoxLayout *dockLayout = new QVBoxLayout(this);
+    dockLayout->setContentsMargins(0, 0, 0, 0);
+    dockLayout->setSpacing(0);
+    mainStack = new QStackedLayout();
+    dockLayout->addLayout(mainStack);
 
     // 1. No Selection Widget
     noSelectionLabel = new QLabel("Select a source to edit", this);
@@ -162,40 +166,154 @@ SourceResizerDock::SourceResizerDock(QWidget *parent) : QWidget(parent)
     fieldGrid->setRowStretch(4, 1);
 
     mainLayout->addLayout(fieldGrid);
+
+    // BOTTOM: Progress of large operations
+    progressLabel = new QLabel(this);
+    progressLabel->setStyleSheet("color: gray;");
+    progressLabel->hide();
+    rootLayout->addWidget(progressLabel);
     
     mainStack->addWidget(controlsWidget);
     mainStack->setCurrentWidget(noSelectionLabel);
 
-    // Create the Popup (Hidden by default)
-    CreateAnchorPopup();
+    // Diagnostics: collapsed by default, only updated while open
+    diagToggle = new QToolButton(this);
+    diagToggle->setText("Diagnostics");
+    diagToggle->setCheckable(true);
+    diagToggle->setAutoRaise(true);
+    diagToggle->setToolButtonStyle(Qt::ToolButtonTextBesideIcon);
+    diagToggle->setArrowType(Qt::RightArrow);
+    dockLayout->addWidget(diagToggle);
+
+    diagLabel = new QLabel(this);
+    diagLabel->setStyleSheet("color: gray; font-family: monospace; font-size: 10px;");
+    diagLabel->setWordWrap(true);
+    diagLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    diagLabel->hide();
+    dockLayout->addWidget(diagLabel);
+
+    diagTimer = new QTimer(this);
+    diagTimer->setInterval(1000);
+    connect(diagTimer, &QTimer::timeout, this, &SourceResizerDock::updateDiagnostics);
+    connect(diagToggle, &QToolButton::toggled, this, [this](bool open) {
+        diagToggle->setArrowType(open ? Qt::DownArrow : Qt::RightArrow);
+        diagLabel->setVisible(open);
+        if (open) {
+            updateDiagnostics();
+            diagTimer->start();
+        } else {
+            diagTimer->stop();
+            diagHistory.clear();
+        }
+    });
+
+    view = std::make_unique<DockViewModel>(DockViewModel::Widgets{mainStack, controlsWidget, noSelectionLabel, nameEdit,
+                                                                  visCheck, xSpin, ySpin, widthSpin, heightSpin,
+                                                                  mainAnchorBtn});
+    latency = std::make_unique<EditLatency>();
+
+    // Pushes block signals, so these only fire for the user's own input.
+    // Connected before the schedulers: a leading-edge Request applies
+    // immediately and must find the input timestamp already recorded
+    const std::pair<QSpinBox*, DockViewModel::Field> spinFields[] = {
+        {xSpin, DockViewModel::Field::X},
+        {ySpin, DockViewModel::Field::Y},
+        {widthSpin, DockViewModel::Field::W},
+        {heightSpin, DockViewModel::Field::H},
+    };
+    for (const auto &spinField : spinFields) {
+        connect(spinField.first, &QSpinBox::valueChanged, this, [this, field = spinField.second]() {
+            view->UserEdited(field);
+            latency->Input();
+        });
+    }
+    connect(nameEdit, &QLineEdit::textEdited, this, [this]() { view->UserEdited(DockViewModel::Field::Name); });
+    connect(visCheck, &QCheckBox::checkStateChanged, this,
+            [this]() { view->UserEdited(DockViewModel::Field::Visible); });
+
+    // Connect input signals (applied at most once per output frame)
+    resizeEdits = new EditScheduler([this]() { handleResize(); }, this);
+    positionEdits = new EditScheduler([this]() { handlePositionChange(); }, this);
+    connect(widthSpin, &QSpinBox::valueChanged, resizeEdits, &EditScheduler::Request);
+    connect(heightSpin, &QSpinBox::valueChanged, resizeEdits, &EditScheduler::Request);
+    connect(xSpin, &QSpinBox::valueChanged, positionEdits, &EditScheduler::Request);
+    connect(ySpin, &QSpinBox::valueChanged, positionEdits, &EditScheduler::Request);
+
+    transformQueue = std::make_unique<TransformQueue>();
+
+    bulkEdits = new BulkScheduler(transformQueue.get(), this);
+    connect(bulkEdits, &BulkScheduler::Progress, this, [this](int done, int total) {
+        progressLabel->setText(QString("Applying %1/%2 (Esc to cancel)").arg(done).arg(total));
+        progressLabel->show();
+    });
 
-    // Connect input signals
-    connect(widthSpin, &QSpinBox::valueChanged, this, &SourceResizerDock::handleResize);
-    connect(heightSpin, &QSpinBox::valueChanged, this, &SourceResizerDock::handleResize);
-    connect(xSpin, &QSpinBox::valueChanged, this, &SourceResizerDock::handlePositionChange);
-    connect(ySpin, &QSpinBox::valueChanged, this, &SourceResizerDock::handlePositionChange);
+    tracker->Transforms().SetQueue(transformQueue.get());
+    connect(bulkEdits, &BulkScheduler::Finished, this, [this](bool cancelled) {
+        latency->Finished(cancelled, transformQueue->LastApplyNs());
+        progressLabel->hide();
+        tracker->RequestRefresh();
+    });
 
-    // Modifier Timer + Selection Polling (for group children which don't emit signals)
-    QTimer *timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, [this]() {
-        updateModifierLabels();
-        RefreshFromSelection(); // Poll for selection changes
+    // Undo/redo/cancel replaced transforms and anchors behind the cache
+    connect(bulkEdits, &BulkScheduler::Restored, this, [this]() {
+        tracker->Transforms().InvalidateAll();
+        tracker->RequestRefresh();
     });
-    timer->start(100);
 
-    // Init OBS
-    obs_frontend_add_event_callback(frontend_event_callback, this);
-    
-    // Initial subscription
+    built = true;
+}
+
+void SourceResizerDock::AttachCurrentScene()
+{
     obs_source_t *source = obs_frontend_get_current_scene();
     if (source) {
         obs_scene_t *scene = obs_scene_from_source(source);
-        SubscribeToScene(scene);
+        tracker->Attach(scene);
         obs_source_release(source);
     }
     RefreshFromSelection();
 }
 
+void SourceResizerDock::Resume()
+{
+    if (active) return;
+    active = true;
+
+    transformQueue->Resume();
+    RefreshFromSelection();
+    if (diagToggle->isChecked()) diagTimer->start();
+}
+
+void SourceResizerDock::Suspend()
+{
+    if (!active) return;
+    active = false;
+
+    // Land what the user already typed; the scene stays tracked for the
+    // group layout, only the widgets stop following it
+    resizeEdits->Flush();
+    positionEdits->Flush();
+    bulkEdits->Finish();
+    transformQueue->Suspend();
+    diagTimer->stop();
+    diagHistory.clear();
+    if (anchorPopup) anchorPopup->hide();
+}
+
+void SourceResizerDock::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (!built) Build();
+    Resume();
+}
+
+void SourceResizerDock::hideEvent(QHideEvent *event)
+{
+    // Also sent when the main window is minimized or the dock tab is covered
+    Suspend();
+    QWidget::hideEvent(event);
+}
+
 void SourceResizerDock::CreateAnchorPopup()
 {
     anchorPopup = new QWidget(this, Qt::Popup);
@@ -226,10 +344,16 @@ void SourceResizerDock::CreateAnchorPopup()
         }
     }
     layout->addLayout(grid);
+
+    // The popup grabs the keyboard while open, so watch it for modifier changes
+    anchorPopup->installEventFilter(this);
 }
 
 void SourceResizerDock::toggleAnchorPopup()
 {
+    // Built on first use, most sessions never open it
+    if (!anchorPopup) CreateAnchorPopup();
+
     if (anchorPopup->isVisible()) {
         anchorPopup->hide();
     } else {
@@ -241,259 +365,298 @@ void SourceResizerDock::toggleAnchorPopup()
 
 SourceResizerDock::~SourceResizerDock()
 {
-    UnsubscribeFromScene();
+    const CanvasRelayout::Stats &relayoutStats = canvasRelayout->GetStats();
+    obs_log(LOG_INFO, "canvas resizes: %llu, %llu of %llu items re-applied (%llu changed)",
+            (unsigned long long)relayoutStats.resets, (unsigned long long)relayoutStats.relaidOut,
+            (unsigned long long)relayoutStats.visited, (unsigned long long)relayoutStats.changed);
+
+    SelectionTracker::Stats stats = tracker->GetStats();
+    obs_log(LOG_INFO, "selection refreshes: %llu run, %llu coalesced, %llu of %llu item signals filtered",
+            (unsigned long long)stats.refreshesRun, (unsigned long long)stats.refreshesCoalesced,
+            (unsigned long long)stats.signalsFiltered, (unsigned long long)stats.signalsReceived);
+    const RectTransformCache::Stats &cacheStats = tracker->Transforms().GetStats();
+    obs_log(LOG_INFO, "transform cache: %llu hits, %llu misses, %llu invalidations",
+            (unsigned long long)cacheStats.hits, (unsigned long long)cacheStats.misses,
+            (unsigned long long)cacheStats.invalidations);
+
+    const GroupLayout::Stats &groupStats = groupLayout->GetStats();
+    obs_log(LOG_INFO, "group layout: %llu groups in %llu frames (%llu solver passes, %llu unsettled), "
+            "%llu children re-applied",
+            (unsigned long long)groupStats.nodesVisited, (unsigned long long)groupStats.frames,
+            (unsigned long long)groupStats.solverPasses, (unsigned long long)groupStats.unconverged,
+            (unsigned long long)groupStats.itemsApplied);
+
+    // Everything else exists only once the dock was shown
+    if (built) {
+        obs_log(LOG_INFO, "spin box edits: %llu applied, %llu intermediate values dropped",
+                (unsigned long long)(resizeEdits->Applied() + positionEdits->Applied()),
+                (unsigned long long)(resizeEdits->Dropped() + positionEdits->Dropped()));
+        TransformQueue::Stats queueStats = transformQueue->GetStats();
+        obs_log(LOG_INFO,
+                "tick-thread transforms: %llu applied over %llu ticks, %llu applied on UI thread (queue full), "
+                "%llu ticks skipped while the UI thread drained",
+                (unsigned long long)queueStats.applied, (unsigned long long)queueStats.ticks,
+                (unsigned long long)queueStats.rejected, (unsigned long long)queueStats.skipped);
+        const BulkScheduler::Stats &bulkStats = bulkEdits->GetStats();
+        obs_log(LOG_INFO, "bulk operations: %llu in %llu chunks, %llu merged, %llu cancelled, %.2f us per item",
+                (unsigned long long)bulkStats.operations, (unsigned long long)bulkStats.chunks,
+                (unsigned long long)bulkStats.merged, (unsigned long long)bulkStats.cancelled,
+                bulkStats.steps ? (double)bulkStats.stepNs / (double)bulkStats.steps / 1000.0 : 0.0);
+
+        const DockViewModel::Stats &viewStats = view->GetStats();
+        obs_log(LOG_INFO, "dock widgets: %llu updates applied, %llu skipped (unchanged)",
+                (unsigned long long)viewStats.applied, (unsigned long long)viewStats.skipped);
+
+        EditLatency::Summary latencyStats = latency->Summarize();
+        obs_log(LOG_INFO, "edit latency: %llu edits, p50 %.2f ms, p99 %.2f ms, max %.2f ms, "
+                "%llu redundant refreshes",
+                (unsigned long long)latencyStats.edits, (double)latencyStats.p50Us / 1000.0,
+                (double)latencyStats.p99Us / 1000.0, (double)latencyStats.maxUs / 1000.0,
+                (unsigned long long)latencyStats.redundantRefreshes);
+
+        // Remaining steps still go through the queue
+        bulkEdits->Finish();
+
+        // Flushes commands that are still queued before items are released
+        tracker->Transforms().SetQueue(nullptr);
+        transformQueue.reset();
+    }
+    tracker->Detach();
+
+    RectTransform::ApplyStats applyStats = RectTransform::GetApplyStats();
+    obs_log(LOG_INFO, "scene item applies: %llu (%llu unchanged), %llu OBS setters called",
+            (unsigned long long)applyStats.applies, (unsigned long long)applyStats.unchanged,
+            (unsigned long long)applyStats.setters);
+
+    PendingSaves::Flush();
+    const PendingSaves::Stats &saveStats = PendingSaves::GetStats();
+    obs_log(LOG_INFO, "deferred saves: %llu recorded (%llu coalesced), %llu written in %llu flushes "
+            "(%.2f ms total, %.2f ms max)",
+            (unsigned long long)saveStats.recorded, (unsigned long long)saveStats.coalesced,
+            (unsigned long long)saveStats.written, (unsigned long long)saveStats.flushes,
+            (double)saveStats.flushNs / 1000000.0, (double)saveStats.maxFlushNs / 1000000.0);
+
+    obs_frontend_remove_save_callback(frontend_save_callback, this);
     obs_frontend_remove_event_callback(frontend_event_callback, this);
 }
 
-void SourceResizerDock::updateModifierLabels()
+void SourceResizerDock::updateDiagnostics()
 {
-    Qt::KeyboardModifiers mods = QApplication::keyboardModifiers();
-    shiftLabel->setStyleSheet(mods & Qt::ShiftModifier ? "color: #00AAFF; font-weight: bold;" : "color: gray;");
-    altLabel->setStyleSheet(mods & Qt::AltModifier ? "color: #00AAFF; font-weight: bold;" : "color: gray;");
-}
+    std::array<PerfStats::Snapshot, PerfStats::ProbeCount> now;
+    for (int p = 0; p < PerfStats::ProbeCount; p++) now[p] = PerfStats::Read((PerfStats::Probe)p);
+
+    // Rolling window: counters since the oldest reading kept (1 s apart)
+    const auto &oldest = diagHistory.empty() ? now : diagHistory.front();
+    char line[256];
+    snprintf(line, sizeof(line), "last %d s:\n", (int)diagHistory.size());
+    std::string text = line;
+    for (int p = 0; p < PerfStats::ProbeCount; p++) {
+        text += PerfStats::Format((PerfStats::Probe)p, PerfStats::Delta(now[p], oldest[p]));
+        text += "\n";
+    }
 
-void SourceResizerDock::keyPressEvent(QKeyEvent *event) { updateModifierLabels(); QWidget::keyPressEvent(event); }
-void SourceResizerDock::keyReleaseEvent(QKeyEvent *event) { updateModifierLabels(); QWidget::keyReleaseEvent(event); }
+    diagHistory.push_back(now);
+    while ((int)diagHistory.size() > diagWindowSeconds) diagHistory.pop_front();
 
-void SourceResizerDock::SubscribeToScene(obs_scene_t *scene)
-{
-    UnsubscribeAll();
-    SubscribeRecursive(scene);
+    EditLatency::Summary edits = latency->Summarize();
+    const DockViewModel::Stats &widgets = view->GetStats();
+    snprintf(line, sizeof(line),
+             "edits: %llu, p50 %.1f ms, p99 %.1f ms, max %.1f ms, %llu redundant refreshes\n"
+             "widget updates: %llu applied, %llu skipped",
+             (unsigned long long)edits.edits, (double)edits.p50Us / 1000.0, (double)edits.p99Us / 1000.0,
+             (double)edits.maxUs / 1000.0, (unsigned long long)edits.redundantRefreshes,
+             (unsigned long long)widgets.applied, (unsigned long long)widgets.skipped);
+    text += line;
+
+    diagLabel->setText(QString::fromUtf8(text.c_str()));
 }
 
-void SourceResizerDock::SubscribeRecursive(obs_scene_t *scene)
+void SourceResizerDock::updateModifierLabels()
 {
-    obs_source_t *source = obs_scene_get_source(scene);
-    if (!source) return;
-
-    // Check if already tracked
-    for (auto *s : trackedSources) {
-        if (s == source) return;
-    }
-
-    obs_source_get_ref(source);
-    trackedSources.push_back(source);
+    if (!anchorPopup) return;
 
-    signal_handler_t *sh = obs_source_get_signal_handler(source);
-    if (sh) {
-        signal_handler_connect(sh, "item_select", OBSSceneItemSignal, this);
-        signal_handler_connect(sh, "item_deselect", OBSSceneItemSignal, this);
-        signal_handler_connect(sh, "item_transform", OBSSceneItemSignal, this);
-    }
-    
-    // Recurse into groups
-    obs_scene_enum_items(scene, [](obs_scene_t *, obs_sceneitem_t *item, void *param) {
-        if (obs_sceneitem_is_group(item)) {
-            obs_scene_t *gScene = obs_sceneitem_group_get_scene(item);
-            if (gScene) {
-                SourceResizerDock *dock = reinterpret_cast<SourceResizerDock*>(param);
-                dock->SubscribeRecursive(gScene);
-            }
-        }
-        return true;
-    }, this);
+    Qt::KeyboardModifiers mods = QApplication::keyboardModifiers();
+    shiftLabel->setStyleSheet(mods & Qt::ShiftModifier ? "color: #00AAFF; font-weight: bold;" : "color: gray;");
+    altLabel->setStyleSheet(mods & Qt::AltModifier ? "color: #00AAFF; font-weight: bold;" : "color: gray;");
 }
 
-void SourceResizerDock::UnsubscribeAll()
+void SourceResizerDock::keyPressEvent(QKeyEvent *event)
 {
-    for (obs_source_t *source : trackedSources) {
-        signal_handler_t *sh = obs_source_get_signal_handler(source);
-        if (sh) {
-            signal_handler_disconnect(sh, "item_select", OBSSceneItemSignal, this);
-            signal_handler_disconnect(sh, "item_deselect", OBSSceneItemSignal, this);
-            signal_handler_disconnect(sh, "item_transform", OBSSceneItemSignal, this);
-        }
-        obs_source_release(source);
+    if (event->key() == Qt::Key_Escape && bulkEdits->Running()) {
+        bulkEdits->Cancel();
+        event->accept();
+        return;
     }
-    trackedSources.clear();
+    updateModifierLabels();
+    QWidget::keyPressEvent(event);
 }
 
-void SourceResizerDock::UnsubscribeFromScene()
-{
-    UnsubscribeAll();
-}
+void SourceResizerDock::keyReleaseEvent(QKeyEvent *event) { updateModifierLabels(); QWidget::keyReleaseEvent(event); }
 
-void SourceResizerDock::OBSSceneItemSignal(void *data, calldata_t *cd)
+bool SourceResizerDock::eventFilter(QObject *watched, QEvent *event)
 {
-    SourceResizerDock *dock = reinterpret_cast<SourceResizerDock*>(data);
-    QMetaObject::invokeMethod(dock, "RefreshFromSelection", Qt::QueuedConnection);
+    if (watched == anchorPopup) {
+        switch (event->type()) {
+            case QEvent::Show:
+            case QEvent::KeyPress:
+            case QEvent::KeyRelease:
+                updateModifierLabels();
+                break;
+            default:
+                break;
+        }
+    }
+    return QWidget::eventFilter(watched, event);
 }
 
 void SourceResizerDock::HandleFrontendEvent(enum obs_frontend_event event)
 {
     if (event == OBS_FRONTEND_EVENT_SCENE_CHANGED) {
-        obs_source_t *source = obs_frontend_get_current_scene();
-        if (source) {
-            obs_scene_t *scene = obs_scene_from_source(source);
-            SubscribeToScene(scene);
-            obs_source_release(source);
-            RefreshFromSelection();
-        }
+        AttachCurrentScene();
+    } else if (event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING) {
+        // The old collection is saved after this; make sure it has our state
+        if (built) bulkEdits->Finish();
+        PendingSaves::Flush();
+    } else if (event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CLEANUP ||
+               event == OBS_FRONTEND_EVENT_EXIT) {
+        // Don't keep scenes of the old collection alive
+        if (built) bulkEdits->Finish();
+        groupLayout->Clear();
+        tracker->Detach();
+        PendingSaves::Flush();
     }
 }
 
 void SourceResizerDock::handleRenaming()
 {
-    obs_source_t *source = obs_frontend_get_current_scene();
-    if (!source) return;
-
-    obs_scene_t *scene = obs_scene_from_source(source);
-    if (!scene) { obs_source_release(source); return; }
-
-    std::function<void(obs_sceneitem_t*)> action = [&](obs_sceneitem_t *item) {
+    tracker->Mirror().ForEachSelected([&](obs_sceneitem_t *item, uint32_t, uint32_t) {
          obs_source_t *itemSource = obs_sceneitem_get_source(item);
          if (itemSource) {
              obs_source_set_name(itemSource, nameEdit->text().toUtf8().constData());
          }
-    };
-
-    EnumSelectedItemsRecursive(scene, action);
-
-    obs_source_release(source);
+    });
 }
 
 void SourceResizerDock::handleVisibility(int state)
 {
-    obs_source_t *source = obs_frontend_get_current_scene();
-    if (!source) return;
-
-    obs_scene_t *scene = obs_scene_from_source(source);
-    if (!scene) { obs_source_release(source); return; }
-
     bool visible = (state == Qt::Checked);
 
-    std::function<void(obs_sceneitem_t*)> action = [&](obs_sceneitem_t *item) {
+    tracker->Mirror().ForEachSelected([&](obs_sceneitem_t *item, uint32_t, uint32_t) {
          obs_sceneitem_set_visible(item, visible);
-    };
-
-    EnumSelectedItemsRecursive(scene, action);
-
-    obs_source_release(source);
+    });
 }
 
 void SourceResizerDock::RefreshFromSelection()
 {
-    obs_source_t *source = obs_frontend_get_current_scene();
-    if (!source) return;
-
-    obs_scene_t *scene = obs_scene_from_source(source);
-    if (!scene) {
-        obs_source_release(source);
-        return;
-    }
+    // Hidden (or not built yet): Resume() refreshes once shown
+    if (!active) return;
 
-    // Ensure we are tracking this scene
-    SubscribeToScene(scene);
+    PerfStats::Scope perf(PerfStats::Refresh);
+    TraceRecorder::Scope trace("refresh");
+    latency->Refresh();
 
-    obs_sceneitem_t *selectedItem = nullptr;
-    uint32_t selectedParentW = 0;
-    uint32_t selectedParentH = 0;
-    
-    // Find first selected item and its parent dims
-    EnumSelectedItemsRecursive(scene, [&](obs_sceneitem_t *item, uint32_t pW, uint32_t pH) {
-        if (!selectedItem) {
-            selectedItem = item;
-            selectedParentW = pW;
-            selectedParentH = pH;
-        }
-    });
+    // First selected item and its parent dims, straight from the mirror
+    const SceneGraphMirror::Node *node = tracker->Mirror().FirstSelected();
+    obs_sceneitem_t *selectedItem = node ? node->item : nullptr;
+    uint32_t selectedParentW = node ? node->parentW : 0;
+    uint32_t selectedParentH = node ? node->parentH : 0;
 
-    // Update UI
+    DockViewModel::State state;
     if (selectedItem) {
-        mainStack->setCurrentWidget(controlsWidget);
+        RectTransform rt = tracker->Transforms().Load(selectedItem, selectedParentW, selectedParentH);
 
-        RectTransform rt = RectTransform::LoadFromItem(selectedItem, selectedParentW, selectedParentH);
-        
         // We display Actual Size (visually correct) and Anchored Position (logically correct)
-        float displayW = rt.GetWidth((float)selectedParentW);
-        float displayH = rt.GetHeight((float)selectedParentH);
-        float displayX = rt.anchoredPosX;
-        float displayY = rt.anchoredPosY;
+        state.hasSelection = true;
+        state.w = (int)rt.GetWidth((float)selectedParentW);
+        state.h = (int)rt.GetHeight((float)selectedParentH);
+        state.x = (int)rt.anchoredPosX;
+        state.y = (int)rt.anchoredPosY;
 
         obs_source_t *itemSource = obs_sceneitem_get_source(selectedItem);
-        const char* name = itemSource ? obs_source_get_name(itemSource) : "";
-        bool visible = obs_sceneitem_visible(selectedItem);
-
-        // Block signals to prevent feedback loop
-        widthSpin->blockSignals(true);
-        heightSpin->blockSignals(true);
-        xSpin->blockSignals(true);
-        ySpin->blockSignals(true);
-        nameEdit->blockSignals(true);
-        visCheck->blockSignals(true);
-
-        widthSpin->setValue((int)displayW);
-        heightSpin->setValue((int)displayH);
-        xSpin->setValue((int)displayX);
-        ySpin->setValue((int)displayY);
-        nameEdit->setText(QString::fromUtf8(name));
-        visCheck->setChecked(visible);
-
-        widthSpin->blockSignals(false);
-        heightSpin->blockSignals(false);
-        xSpin->blockSignals(false);
-        ySpin->blockSignals(false);
-        nameEdit->blockSignals(false);
-        visCheck->blockSignals(false);
-        
-        this->setEnabled(true);
-    } else {
-        mainStack->setCurrentWidget(noSelectionLabel);
+        const char *name = itemSource ? obs_source_get_name(itemSource) : nullptr;
+        state.name = name ? name : "";
+        state.visible = obs_sceneitem_visible(selectedItem);
+        state.hasPreset = DockViewModel::MatchPreset(rt, state.anchorH, state.anchorV);
     }
 
-    obs_source_release(source);
+    // Only fields that changed reach the widgets (signals blocked to prevent feedback)
+    view->Show(state, resizeEdits->Pending(), positionEdits->Pending());
+}
+
+void SourceResizerDock::StartBulk(const char *name, bool repeatable,
+                                  std::function<void(obs_sceneitem_t *item, uint32_t parentW, uint32_t parentH)> step)
+{
+    // Inputs without anything to edit are not measured
+    uint64_t inputNs = latency->TakeInput();
+    obs_scene_t *scene = tracker->RootScene();
+    if (!scene) return;
+
+    const SceneGraphMirror &mirror = tracker->Mirror();
+    std::vector<BulkScheduler::Target> targets;
+    targets.reserve(mirror.SelectedCount());
+    mirror.ForEachSelected([&](obs_sceneitem_t *item, uint32_t parentW, uint32_t parentH) {
+        targets.push_back({item, parentW, parentH});
+    });
+    if (targets.empty()) return;
+
+    bulkEdits->Start(name, repeatable, scene, std::move(targets), std::move(step));
+    if (bulkEdits->Running()) latency->InFlight(inputNs);
+    else latency->Landed(inputNs, os_gettime_ns());
 }
 
 void SourceResizerDock::handleResize()
 {
-    obs_source_t *source = obs_frontend_get_current_scene();
-    if (!source) return;
-    
-    obs_scene_t *scene = obs_scene_from_source(source);
-    if (!scene) { obs_source_release(source); return; }
+    float targetW = (float)widthSpin->value();
+    float targetH = (float)heightSpin->value();
 
-    EnumSelectedItemsRecursive(scene, [&](obs_sceneitem_t *item, uint32_t pW, uint32_t pH) {
-        RectTransform rt = RectTransform::LoadFromItem(item, pW, pH);
-        
-        float targetW = (float)widthSpin->value();
-        float targetH = (float)heightSpin->value();
+    StartBulk("Resize sources", true, [this, targetW, targetH](obs_sceneitem_t *item, uint32_t pW, uint32_t pH) {
+        RectTransform rt = tracker->Transforms().Load(item, pW, pH);
         
         // Calculate needed sizeDelta to achieve target size
-        float ax0 = (float)pW * rt.anchorMinX;
-        float ay0 = (float)pH * rt.anchorMinY;
-        float ax1 = (float)pW * rt.anchorMaxX;
-        float ay1 = (float)pH * rt.anchorMaxY;
-        float anchorRectW = ax1 - ax0;
-        float anchorRectH = ay1 - ay0;
+        rt.sizeDeltaX = targetW - RectLayout::AnchorSpan((float)pW, rt.anchorMinX, rt.anchorMaxX).size;
+        rt.sizeDeltaY = targetH - RectLayout::AnchorSpan((float)pH, rt.anchorMinY, rt.anchorMaxY).size;
         
-        rt.sizeDeltaX = targetW - anchorRectW;
-        rt.sizeDeltaY = targetH - anchorRectH;
-        
-        rt.ApplyToSceneItem(item, pW, pH);
+        CommitTransform(item, rt, pW, pH);
     });
-
-    obs_source_release(source);
 }
 
 
 void SourceResizerDock::handlePositionChange()
 {
-    obs_source_t *source = obs_frontend_get_current_scene();
-    if (!source) return;
-    
-    obs_scene_t *scene = obs_scene_from_source(source);
-    if (!scene) { obs_source_release(source); return; }
+    float targetX = (float)xSpin->value();
+    float targetY = (float)ySpin->value();
 
-    EnumSelectedItemsRecursive(scene, [&](obs_sceneitem_t *item, uint32_t pW, uint32_t pH) {
-        RectTransform rt = RectTransform::LoadFromItem(item, pW, pH);
+    StartBulk("Move sources", true, [this, targetX, targetY](obs_sceneitem_t *item, uint32_t pW, uint32_t pH) {
+        RectTransform rt = tracker->Transforms().Load(item, pW, pH);
         
-        rt.anchoredPosX = (float)xSpin->value();
-        rt.anchoredPosY = (float)ySpin->value();
+        rt.anchoredPosX = targetX;
+        rt.anchoredPosY = targetY;
         
-        rt.ApplyToSceneItem(item, pW, pH);
+        CommitTransform(item, rt, pW, pH);
     });
+}
+
+void SourceResizerDock::CommitTransform(obs_sceneitem_t *item, const RectTransform &rt, uint32_t parentW,
+                                        uint32_t parentH)
+{
+    RectTransformCache &cache = tracker->Transforms();
+
+    // Tick mode: the graphics thread applies it before the next frame,
+    // recording and caching the target state happens here right away
+    if (applyOnTick) {
+        uint64_t ticket = transformQueue->Push(item, rt, parentW, parentH);
+        if (ticket) {
+            PendingSaves::Record(item, rt);
+            cache.StoreExpected(item, rt, parentW, parentH, ticket);
+            return;
+        }
+
+        // Queue full: older commands (possibly for this item) land first
+        transformQueue->Drain();
+    }
 
-    obs_source_release(source);
+    rt.ApplyToSceneItem(item, parentW, parentH);
+    cache.Store(item, rt, parentW, parentH);
 }
 
 void SourceResizerDock::onAnchorClicked()
@@ -506,200 +669,22 @@ void SourceResizerDock::onAnchorClicked()
 
 void SourceResizerDock::ApplyAnchorPreset(AnchorH h, AnchorV v)
 {
-    obs_source_t *source = obs_frontend_get_current_scene();
-    if (!source) return;
-
-    obs_scene_t *scene = obs_scene_from_source(source);
-    if (!scene) { obs_source_release(source); return; }
-
     Qt::KeyboardModifiers mods = QApplication::keyboardModifiers();
     bool shiftHeld = (mods & Qt::ShiftModifier);
     bool altHeld = (mods & Qt::AltModifier);
     
+    latency->Input();
+
     // Get preset anchor/pivot values
     AnchorPreset preset = AnchorPreset::FromEnums(static_cast<int>(h), static_cast<int>(v));
     
-    // Use the new helper that provides parent dimensions
-    EnumSelectedItemsRecursive(scene, [&](obs_sceneitem_t *item, uint32_t parentW, uint32_t parentH) {
-        
+    // Selected items with their cached parent dimensions and RectTransform state
+    StartBulk("Apply anchor preset", false, [this, preset, shiftHeld, altHeld](obs_sceneitem_t *item, uint32_t parentW,
+                                                                             uint32_t parentH) {
         // Load current RectTransform state (inferred from live OBS state)
-        RectTransform rt = RectTransform::LoadFromItem(item, parentW, parentH);
-        
-        if (!shiftHeld && !altHeld) {
-            // === Normal click: Change anchor, preserve world rect position ===
-            float oldX, oldY, oldW, oldH;
-            rt.CalculateFinalRect((float)parentW, (float)parentH, oldX, oldY, oldW, oldH);
-            float oldPivotWorldX = oldX + oldW * rt.pivotX;
-            float oldPivotWorldY = oldY + oldH * rt.pivotY;
-            
-            // Apply new anchors
-            rt.anchorMinX = preset.minX;
-            rt.anchorMinY = preset.minY;
-            rt.anchorMaxX = preset.maxX;
-            rt.anchorMaxY = preset.maxY;
-            
-            // Calculate new anchor rect
-            float ax0 = (float)parentW * rt.anchorMinX;
-            float ay0 = (float)parentH * rt.anchorMinY;
-            float ax1 = (float)parentW * rt.anchorMaxX;
-            float ay1 = (float)parentH * rt.anchorMaxY;
-            float anchorRectW = ax1 - ax0;
-            float anchorRectH = ay1 - ay0;
-            
-            // Recalculate sizeDelta to maintain old size
-            rt.sizeDeltaX = oldW - anchorRectW;
-            rt.sizeDeltaY = oldH - anchorRectH;
-            
-            // Calculate new anchor pivot point
-            float newAnchorPivotX = ax0 + anchorRectW * rt.pivotX;
-            float newAnchorPivotY = ay0 + anchorRectH * rt.pivotY;
-            
-            // Recalculate anchoredPosition to keep pivot at same world pos
-            rt.anchoredPosX = oldPivotWorldX - newAnchorPivotX;
-            rt.anchoredPosY = oldPivotWorldY - newAnchorPivotY;
-            
-            rt.ApplyToSceneItem(item, parentW, parentH);
-        }
-        else if (shiftHeld && !altHeld) {
-            // === Shift: Change anchor + move to anchor position ===
-            rt.anchorMinX = preset.minX;
-            rt.anchorMinY = preset.minY;
-            rt.anchorMaxX = preset.maxX;
-            rt.anchorMaxY = preset.maxY;
-            
-            // Reset offset (snap to anchor)
-            rt.anchoredPosX = 0.0f;
-            rt.anchoredPosY = 0.0f;
-            
-            rt.ApplyToSceneItem(item, parentW, parentH);
-        }
-        else if (shiftHeld && altHeld) {
-            // === Shift+Alt: Full preset reset (anchor + pivot + pos + size) ===
-            rt.anchorMinX = preset.minX;
-            rt.anchorMinY = preset.minY;
-            rt.anchorMaxX = preset.maxX;
-            rt.anchorMaxY = preset.maxY;
-            rt.pivotX = preset.pivotX;
-            rt.pivotY = preset.pivotY;
-            
-            // Reset offset
-            rt.anchoredPosX = 0.0f;
-            rt.anchoredPosY = 0.0f;
-            
-            // Reset size: For stretch axes, sizeDelta=0 implies filling the anchor rect.
-            if (preset.minX != preset.maxX) {
-                rt.sizeDeltaX = 0.0f;  // Horizontal stretch
-            } else {
-                // For fixed axes, reset to 'default' or keep current?
-                // Unity resets to 100x100 usually. Let's try to keep meaningful size if possible, 
-                // but "reset" implies reset. Let's use 100 if we can't determine.
-                // Or better: Reset means "match preset". 
-                // We'll set arbitrary default size 200px if it was stretched before, 
-                // or keep current size if it's already fixed? 
-                // User said "Shift+Alt ... sizeDelta value 0".
-                // If I set sizeDelta to 0 for a non-stretch anchor, size becomes 0! That's bad (invisible).
-                
-                // Let's use the current "Width" of the item as the delta.
-                float currentW = rt.GetWidth((float)parentW);
-                rt.sizeDeltaX = (currentW > 1.0f) ? currentW : 200.0f;
-            }
-            
-            if (preset.minY != preset.maxY) {
-                rt.sizeDeltaY = 0.0f;  // Vertical stretch
-            } else {
-                float currentH = rt.GetHeight((float)parentH);
-                rt.sizeDeltaY = (currentH > 1.0f) ? currentH : 200.0f;
-            }
-            
-            rt.ApplyToSceneItem(item, parentW, parentH);
-        }
-        else if (altHeld && !shiftHeld) {
-            // === Alt only: Just move to position (legacy behavior) ===
-            rt.anchoredPosX = 0.0f;
-            rt.anchoredPosY = 0.0f;
-            
-            // Temporarily apply preset anchors for calculation (simulate "what if we were anchored here")
-            // BUT we don't change the actual anchors stored in 'rt'.
-            // Wait, legacy behavior sets position based on those anchors? 
-            // In Unity, Alt-click sets position BUT NOT ANCHORS. 
-            // It moves the pivot to the anchor point defined by the preset.
-            // So we calculate where that point is, and move there.
-            
-            // Calculate usage of preset anchors
-            float ax0 = (float)parentW * preset.minX;
-            float ay0 = (float)parentH * preset.minY;
-            float ax1 = (float)parentW * preset.maxX;
-            float ay1 = (float)parentH * preset.maxY;
-            float anchorRectW = ax1 - ax0;
-            float anchorRectH = ay1 - ay0;
-            
-            // Target anchor pivot position
-            float targetPivotX = ax0 + anchorRectW * rt.pivotX;
-            float targetPivotY = ay0 + anchorRectH * rt.pivotY;
-            
-            // Current Pivot World Pos
-            float currentX, currentY, currentW, currentH;
-            rt.CalculateFinalRect((float)parentW, (float)parentH, currentX, currentY, currentW, currentH);
-            float currentPivotWorldX = currentX + currentW * rt.pivotX;
-            float currentPivotWorldY = currentY + currentH * rt.pivotY;
-            
-            // We want to move 'currentPivotWorld' to 'targetPivot'.
-            // anchoredPos = (TargetPos - AnchorPivot) ... 
-            // If we don't change anchors, 'AnchorPivot' is based on OLD anchors.
-            // anchoredPos = targetPivot - oldAnchorPivot.
-            
-            // Wait, Unity Alt Click: "Sets position".
-            // If I Alt-click "Top Left", it moves the object to Top-Left corner.
-            // It modifies 'anchoredPosition' such that the object is visually at Top Left.
-            // It does NOT change anchors.
-            
-            float oldAx0 = (float)parentW * rt.anchorMinX;
-            float oldAy0 = (float)parentH * rt.anchorMinY;
-            float oldAx1 = (float)parentW * rt.anchorMaxX;
-            float oldAy1 = (float)parentH * rt.anchorMaxY;
-            float oldAnchorRectW = oldAx1 - oldAx0;
-            float oldAnchorRectH = oldAy1 - oldAy0;
-            
-            float oldAnchorPivotX = oldAx0 + oldAnchorRectW * rt.pivotX;
-            float oldAnchorPivotY = oldAy0 + oldAnchorRectH * rt.pivotY;
-            
-            // We want the object's pivot to be at targetPivotX/Y
-            // WorldPivot = OldAnchorPivot + NewAnchoredPos
-            // NewAnchoredPos = TargetPivot - OldAnchorPivot
-            
-            rt.anchoredPosX = targetPivotX - oldAnchorPivotX;
-            rt.anchoredPosY = targetPivotY - oldAnchorPivotY;
-            
-            // Special case: If preset is stretch, we also resize?
-            // Unity Alt-Click on Stretch Preset: Resizes to fill that dimension.
-            // So if I accept resizing...
-            if (preset.minX != preset.maxX) {
-                // Resize width to match parent width
-                // sizeDeltaX = width - anchorRectW
-                // We want width = parentW
-                // So sizeDeltaX = parentW - anchorRectW
-                 rt.sizeDeltaX = (float)parentW - oldAnchorRectW;
-                 
-                 // And we also align X to 0? 
-                 // If we stretch, position should center.
-                 // anchoredPos for X becomes 0 if fully centered?
-                 // Let's stick to standard "Fill" logic: 0 offset from anchors.
-                 // But we aren't changing anchors!
-                 // If anchors are center, and we stretch:
-                 // Width becomes parentW. Pivot is center.
-                 // Position is center.
-                 // So yes, anchoredPosX = 0.
-            }
-            if (preset.minY != preset.maxY) {
-                 rt.sizeDeltaY = (float)parentH - oldAnchorRectH;
-            }
-            
-            // Re-apply
-            rt.ApplyToSceneItem(item, parentW, parentH);
-        }
+        RectTransform rt = tracker->Transforms().Load(item, parentW, parentH);
+        rt.ApplyPreset(preset, shiftHeld, altHeld, (float)parentW, (float)parentH);
+        CommitTransform(item, rt, parentW, parentH);
     });
-
-    obs_source_release(source);
-    RefreshFromSelection();
 }
 
@@ -3,8 +3,13 @@
 #include <QWidget>
 #include <obs-module.h>
 #include <obs-frontend-api.h>
-#include <vector>
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
 #include "anchor-button.hpp"
+#include "perf-stats.hpp"
+#include "rect-transform.hpp"
 
 class QSpinBox;
 class QPushButton;
@@ -12,6 +17,16 @@ class QLabel;
 class QStackedLayout;
 class QLineEdit;
 class QCheckBox;
+class QTimer;
+class QToolButton;
+class SelectionTracker;
+class EditScheduler;
+class TransformQueue;
+class BulkScheduler;
+class CanvasRelayout;
+class GroupLayout;
+class DockViewModel;
+class EditLatency;
 
 class SourceResizerDock : public QWidget {
     Q_OBJECT
@@ -23,12 +38,18 @@ public:
     // Called by global event callback or self-registered
     void HandleFrontendEvent(enum obs_frontend_event event);
 
+    /** Input-to-scene latency of the edits so far (valid once shown) */
+    const EditLatency &Latency() const { return *latency; }
+
 public slots:
     void RefreshFromSelection();
 
 protected:
     void keyPressEvent(QKeyEvent *event) override;
     void keyReleaseEvent(QKeyEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
 
 private slots:
     void handleResize();
@@ -38,15 +59,25 @@ private slots:
     void toggleAnchorPopup();
     void handleRenaming();
     void handleVisibility(int state);
+    void updateDiagnostics();
 
 private:
-    void SubscribeToScene(obs_scene_t *scene);
-    void UnsubscribeFromScene();
+    /** Widgets and edit machinery, on first show */
+    void Build();
+    /** Start per-frame edit work and follow the selection again (shown) */
+    void Resume();
+    /** Land pending edits, stop tick work and widget refreshes (hidden or minimized) */
+    void Suspend();
+    void AttachCurrentScene();
+
     void ApplyAnchorPreset(AnchorH h, AnchorV v);
     void CreateAnchorPopup();
-    
-    // Static callbacks for OBS signals
-    static void OBSSceneItemSignal(void *data, calldata_t *cd);
+    void CommitTransform(obs_sceneitem_t *item, const RectTransform &rt, uint32_t parentW, uint32_t parentH);
+    void StartBulk(const char *name, bool repeatable,
+                   std::function<void(obs_sceneitem_t *item, uint32_t parentW, uint32_t parentH)> step);
+
+    bool built = false;
+    bool active = false;
 
     QStackedLayout *mainStack;
     QWidget *controlsWidget;
@@ -62,15 +93,47 @@ private:
     QSpinBox *xSpin;
     QSpinBox *ySpin;
     
-    // Popup Elements
-    QWidget *anchorPopup;
+    // Last displayed values; only changed fields reach the widgets
+    std::unique_ptr<DockViewModel> view;
+    
+    // Time from user input until the edit is in the scene
+    std::unique_ptr<EditLatency> latency;
+    
+    // Frame-aligned throttling of spin box edits (latest value wins)
+    EditScheduler *resizeEdits;
+    EditScheduler *positionEdits;
     
-    // Track multiple sources (Main scene + Groups)
-    std::vector<obs_source_t*> trackedSources;
+    // Popup Elements (created when first opened)
+    QWidget *anchorPopup = nullptr;
     
-    void SubscribeRecursive(obs_scene_t *scene);
-    void UnsubscribeAll();
+    // Signal-driven selection tracking (Main scene + Groups)
+    SelectionTracker *tracker;
+    
+    // Execution mode: apply transforms on the OBS tick thread (queued)
+    // instead of synchronously on the UI thread
+    bool applyOnTick = true;
+    std::unique_ptr<TransformQueue> transformQueue;
+    
+    // Edits of the whole selection, chunked over frames; one undo unit each
+    BulkScheduler *bulkEdits;
+    QLabel *progressLabel;
+    
+    // Re-applies anchored items in all scenes when the canvas size changes
+    CanvasRelayout *canvasRelayout;
+    
+    // Re-applies anchored group children when a group's contents resize
+    GroupLayout *groupLayout;
+    
+    // Collapsible live counters (PerfStats, edit latency, widget updates)
+    QToolButton *diagToggle;
+    QLabel *diagLabel;
+    QTimer *diagTimer;
+
+    // One PerfStats reading per diagnostics tick; the panel shows the
+    // difference to the oldest, i.e. the last diagWindowSeconds
+    static const int diagWindowSeconds = 10;
+    std::deque<std::array<PerfStats::Snapshot, PerfStats::ProbeCount>> diagHistory;
     
-    QLabel *shiftLabel;
-    QLabel *altLabel;
+    QLabel *shiftLabel = nullptr;
+    QLabel *altLabel = nullptr;
 };
@@ -0,0 +1,193 @@
+#include "trace-recorder.hpp"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Written by the owning thread only. 'seq' is odd while a slot is being
+// rewritten, so the exporter can skip slots it raced with.
+struct Slot {
+    std::atomic<uint32_t> seq{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> start{0};
+    std::atomic<uint64_t> duration{0};
+};
+
+struct Ring {
+    uint32_t tid = 0;
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> head{0}; // Events written so far
+    bool retired = false;          // Owning thread exited (ringsMutex)
+    Slot slots[TraceRecorder::ringSize];
+};
+
+// Retired rings kept beyond this are freed oldest first
+const size_t maxRetired = 4;
+
+// Never destroyed: threads may exit after the module's statics are gone
+std::mutex &RingsMutex()
+{
+    static std::mutex *mutex = new std::mutex();
+    return *mutex;
+}
+
+std::vector<Ring*> &Rings()
+{
+    static std::vector<Ring*> *rings = new std::vector<Ring*>();
+    return *rings;
+}
+
+// Caller holds RingsMutex; 'keep' retired rings survive
+void FreeRetired(size_t keep)
+{
+    std::vector<Ring*> &rings = Rings();
+    size_t retired = 0;
+    for (Ring *ring : rings) retired += ring->retired;
+
+    for (auto it = rings.begin(); it != rings.end() && retired > keep;) {
+        if (!(*it)->retired) {
+            ++it;
+            continue;
+        }
+        delete *it;
+        it = rings.erase(it);
+        retired--;
+    }
+}
+
+// Retires the thread's ring when the thread exits
+struct RingOwner {
+    Ring *ring = nullptr;
+    const char *name = nullptr; // NameThread() before the ring exists
+
+    ~RingOwner()
+    {
+        if (!ring) return;
+        std::lock_guard<std::mutex> lock(RingsMutex());
+        ring->retired = true;
+        FreeRetired(maxRetired);
+    }
+};
+
+thread_local RingOwner owner;
+uint32_t nextTid = 1; // RingsMutex
+
+Ring *ThreadRing()
+{
+    if (owner.ring) return owner.ring;
+
+    Ring *ring = new Ring();
+    ring->name.store(owner.name, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(RingsMutex());
+    ring->tid = nextTid++;
+    Rings().push_back(ring);
+    owner.ring = ring;
+    return ring;
+}
+
+void WriteString(FILE *f, const char *s)
+{
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+} // namespace
+
+std::atomic<bool> TraceRecorder::enabled{false};
+
+void TraceRecorder::SetEnabled(bool on)
+{
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+void TraceRecorder::Record(const char *name, uint64_t startNs, uint64_t durationNs)
+{
+    if (!Enabled()) return;
+
+    Ring *ring = ThreadRing();
+    uint64_t n = ring->head.load(std::memory_order_relaxed);
+    Slot &slot = ring->slots[n & (ringSize - 1)];
+
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(startNs, std::memory_order_relaxed);
+    slot.duration.store(durationNs, std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+
+    ring->head.store(n + 1, std::memory_order_release);
+}
+
+void TraceRecorder::NameThread(const char *name)
+{
+    if (owner.name) return;
+    owner.name = name;
+    if (owner.ring) owner.ring->name.store(name, std::memory_order_relaxed);
+}
+
+int TraceRecorder::WriteChromeTrace(const char *path, double seconds)
+{
+    // Held throughout so exiting threads can't free a ring being read;
+    // only a thread's first event and thread exit wait for it
+    std::lock_guard<std::mutex> lock(RingsMutex());
+    const std::vector<Ring*> &snapshot = Rings();
+
+    FILE *f = os_fopen(path, "wb");
+    if (!f) return -1;
+
+    uint64_t now = os_gettime_ns();
+    uint64_t windowNs = (uint64_t)(seconds * 1000000000.0);
+    uint64_t since = now > windowNs ? now - windowNs : 0;
+    int written = 0;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    for (Ring *ring : snapshot) {
+        // Thread name metadata
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                written ? ",\n" : "", ring->tid);
+        const char *threadName = ring->name.load(std::memory_order_relaxed);
+        if (threadName) {
+            WriteString(f, threadName);
+        } else {
+            fprintf(f, "\"thread %u\"", ring->tid);
+        }
+        fputs("}}", f);
+        written++;
+
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t first = head > ringSize ? head - ringSize : 0;
+        for (uint64_t i = first; i < head; i++) {
+            const Slot &slot = ring->slots[i & (ringSize - 1)];
+            uint32_t seq = slot.seq.load(std::memory_order_acquire);
+            const char *name = slot.name.load(std::memory_order_relaxed);
+            uint64_t start = slot.start.load(std::memory_order_relaxed);
+            uint64_t duration = slot.duration.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // Overwritten while reading, or still being written
+            if ((seq & 1) || seq != slot.seq.load(std::memory_order_relaxed) || !name) continue;
+            if (start + duration < since) continue;
+
+            fputs(",\n{\"name\":", f);
+            WriteString(f, name);
+            fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", ring->tid,
+                    (double)start / 1000.0, (double)duration / 1000.0);
+            written++;
+        }
+    }
+    fputs("\n]}\n", f);
+    int threads = (int)snapshot.size();
+
+    // Exited threads' events are in this trace now
+    FreeRetired(0);
+
+    bool ok = fclose(f) == 0;
+    return ok ? written - threads : -1;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <util/platform.h>
+
+/**
+ * Timeline tracing into per-thread ring buffers
+ *
+ * Off by default: a disabled Scope is a relaxed load and no clock read,
+ * and threads get no ring until they record while enabled.
+ *
+ * Scope records a complete event (name, start, duration) into a ring
+ * owned by the calling thread; nothing is shared between writers and no
+ * lock is taken after a thread's first event. Rings keep the last
+ * ringSize events each. When a thread exits its ring is retired: kept
+ * for the next export (its events are still within the window), freed
+ * after that or once more than a few retired rings pile up.
+ *
+ * WriteChromeTrace() dumps the last few seconds as Chrome trace-event
+ * JSON (chrome://tracing, Perfetto). Timestamps come from os_gettime_ns,
+ * the clock OBS uses for its own frame timing. Threads appear under the
+ * name given by NameThread() (e.g. "obs graphics") or as "thread N".
+ *
+ * Event names must be string literals (only the pointer is stored).
+ */
+class TraceRecorder {
+public:
+    static const uint32_t ringSize = 16384; // Events per thread, power of two
+
+    class Scope {
+    public:
+        explicit Scope(const char *name) : name(name), start(Enabled() ? os_gettime_ns() : 0) {}
+        ~Scope()
+        {
+            if (start) Record(name, start, os_gettime_ns() - start);
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const char *name;
+        uint64_t start;
+    };
+
+    static bool Enabled() { return enabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool on);
+
+    static void Record(const char *name, uint64_t startNs, uint64_t durationNs);
+
+    /** Label the calling thread in exported traces (literal, first call wins) */
+    static void NameThread(const char *name);
+
+    /** Write events that ended in the last 'seconds'. Returns events written, -1 on error */
+    static int WriteChromeTrace(const char *path, double seconds);
+
+private:
+    static std::atomic<bool> enabled;
+};
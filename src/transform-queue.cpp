@@ -0,0 +1,114 @@
+#include "transform-queue.hpp"
+#include <util/platform.h>
+#include "trace-recorder.hpp"
+
+static size_t RoundUpPow2(size_t v)
+{
+    size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+TransformQueue::TransformQueue(size_t capacity)
+{
+    ring.resize(RoundUpPow2(capacity < 2 ? 2 : capacity));
+    mask = ring.size() - 1;
+
+    Resume();
+}
+
+TransformQueue::~TransformQueue()
+{
+    Suspend();
+}
+
+void TransformQueue::Suspend()
+{
+    // After this returns the tick callback can no longer run
+    if (ticking) obs_remove_tick_callback(Tick, this);
+    ticking = false;
+    Drain();
+}
+
+void TransformQueue::Resume()
+{
+    if (ticking) return;
+    obs_add_tick_callback(Tick, this);
+    ticking = true;
+}
+
+uint64_t TransformQueue::Push(obs_sceneitem_t *item, const RectTransform &rt, uint32_t parentW, uint32_t parentH)
+{
+    if (!item) return 0;
+
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) >= ring.size()) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+
+    obs_sceneitem_addref(item);
+
+    Command &cmd = ring[t & mask];
+    cmd.item = item;
+    cmd.rt = rt;
+    cmd.parentW = parentW;
+    cmd.parentH = parentH;
+
+    tail.store(t + 1, std::memory_order_release);
+    pushed.fetch_add(1, std::memory_order_relaxed);
+    return (uint64_t)t + 1;
+}
+
+void TransformQueue::Drain()
+{
+    std::lock_guard<std::mutex> lock(drainMutex);
+    DrainLocked();
+}
+
+void TransformQueue::DrainLocked()
+{
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t = tail.load(std::memory_order_acquire);
+    if (h == t) return;
+
+    for (; h != t; h++) {
+        Command &cmd = ring[h & mask];
+        cmd.rt.ApplyToSceneItem(cmd.item, cmd.parentW, cmd.parentH, false);
+        obs_sceneitem_release(cmd.item);
+        cmd.item = nullptr;
+    }
+
+    applied.fetch_add(t - head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    head.store(t, std::memory_order_release);
+    ticks.fetch_add(1, std::memory_order_relaxed);
+    lastApplyNs.store(os_gettime_ns(), std::memory_order_relaxed);
+}
+
+void TransformQueue::Tick(void *param, float)
+{
+    // Once per output frame: the frame grid in exported traces
+    TraceRecorder::NameThread("obs graphics");
+    TraceRecorder::Scope trace("frame tick");
+
+    // Never wait on the UI thread from the graphics thread: if it is
+    // draining right now, whatever it leaves behind goes out next frame
+    TransformQueue *queue = reinterpret_cast<TransformQueue*>(param);
+    std::unique_lock<std::mutex> lock(queue->drainMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        queue->skipped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    queue->DrainLocked();
+}
+
+TransformQueue::Stats TransformQueue::GetStats() const
+{
+    Stats stats;
+    stats.pushed = pushed.load(std::memory_order_relaxed);
+    stats.applied = applied.load(std::memory_order_relaxed);
+    stats.rejected = rejected.load(std::memory_order_relaxed);
+    stats.ticks = ticks.load(std::memory_order_relaxed);
+    stats.skipped = skipped.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <obs.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "rect-transform.hpp"
+
+/**
+ * Lock-free single-producer/single-consumer queue of transform commands
+ *
+ * The dock (UI thread, producer) pushes compact commands; a callback
+ * registered with obs_add_tick_callback (graphics thread, consumer) drains
+ * the queue once per frame and applies them with ApplyToSceneItem. The UI
+ * thread never holds scene or item locks for the float math and setters,
+ * and all edits of one frame land together right before it is rendered.
+ *
+ * Commands hold a reference on their item until applied. Persisting the
+ * state (private settings) stays on the UI thread.
+ *
+ * The UI thread may also drain (e.g. before a synchronous apply when the
+ * queue is full); a mutex keeps the consumer side single-threaded. The
+ * tick only try-locks it and skips the frame while the UI thread holds it,
+ * so rendering never waits on the UI thread.
+ */
+class TransformQueue {
+public:
+    struct Stats {
+        uint64_t pushed = 0;
+        uint64_t applied = 0;
+        uint64_t rejected = 0; // Queue full, caller drained and applied synchronously
+        uint64_t ticks = 0;    // Ticks that drained at least one command
+        uint64_t skipped = 0;  // Ticks skipped because the UI thread was draining
+    };
+
+    explicit TransformQueue(size_t capacity = 4096);
+    ~TransformQueue();
+
+    TransformQueue(const TransformQueue &) = delete;
+    TransformQueue &operator=(const TransformQueue &) = delete;
+
+    /**
+     * Producer side. Returns a ticket for Applied(), or 0 if the queue is
+     * full (nothing queued)
+     */
+    uint64_t Push(obs_sceneitem_t *item, const RectTransform &rt, uint32_t parentW, uint32_t parentH);
+
+    /** True once the command with this ticket (and all before it) was applied */
+    bool Applied(uint64_t ticket) const { return head.load(std::memory_order_acquire) >= ticket; }
+
+    /** Apply everything still queued on the calling thread */
+    void Drain();
+
+    /** Stop draining on the tick thread (applies what is queued); Resume() restarts it */
+    void Suspend();
+    void Resume();
+
+    /** os_gettime_ns of the last tick that applied commands (0 = none yet) */
+    uint64_t LastApplyNs() const { return lastApplyNs.load(std::memory_order_relaxed); }
+
+    /** True once the consumer applied everything pushed so far */
+    bool Empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+    Stats GetStats() const;
+
+private:
+    struct Command {
+        obs_sceneitem_t *item;
+        RectTransform rt;
+        uint32_t parentW;
+        uint32_t parentH;
+    };
+
+    static void Tick(void *param, float seconds);
+    void DrainLocked(); // Caller holds drainMutex
+
+    std::vector<Command> ring;
+    size_t mask;
+    bool ticking = false; // Tick callback registered (UI thread only)
+    std::mutex drainMutex;  // Tick thread vs. UI-thread Drain()
+
+    // Producer writes tail, consumer writes head; each on its own cache line
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> applied{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint64_t> skipped{0};
+    std::atomic<uint64_t> lastApplyNs{0};
+};
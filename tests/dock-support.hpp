@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSpinBox>
+#include <QThread>
+#include <QWidget>
+
+/** Helpers for driving SourceResizerDock on the offscreen platform */
+namespace DockSupport {
+
+/** Run queued refreshes and frame-aligned edits (EditScheduler waits up to one frame) */
+inline void Pump(int ms = 50)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < ms) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+        QThread::msleep(1);
+    }
+}
+
+struct Spins {
+    QSpinBox *x = nullptr, *y = nullptr, *w = nullptr, *h = nullptr;
+};
+
+/** The dock creates X, Y, Width, Height in that order; positions accept negative values */
+inline Spins FindSpins(QWidget &dock)
+{
+    Spins spins;
+    for (QSpinBox *spin : dock.findChildren<QSpinBox*>()) {
+        QSpinBox *&slot = spin->minimum() < 0 ? (spins.x ? spins.y : spins.x) : (spins.w ? spins.h : spins.w);
+        slot = spin;
+    }
+    return spins;
+}
+
+} // namespace DockSupport
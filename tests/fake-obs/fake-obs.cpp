@@ -0,0 +1,1257 @@
+#include "fake-obs.hpp"
+#include <obs-module.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ===== Data model =====
+
+struct calldata {
+    std::map<std::string, void*> ptrs;
+    std::map<std::string, bool> bools;
+};
+
+struct signal_handler {
+    struct Slot {
+        signal_callback_t callback;
+        void *data;
+    };
+    std::map<std::string, std::vector<Slot>> slots;
+
+    void Emit(const char *signal, calldata_t *cd);
+};
+
+struct obs_data_array;
+
+struct FakeValue {
+    enum Type { String, Int, Double, Bool, Object, Array } type = String;
+    std::string s;
+    long long i = 0;
+    double d = 0.0;
+    bool b = false;
+    obs_data *obj = nullptr;
+    obs_data_array *array = nullptr;
+};
+
+struct obs_data {
+    long refs = 1;
+    std::vector<std::pair<std::string, FakeValue>> values; // Insertion order, like libobs
+    std::string json;
+
+    FakeValue *Find(const char *name)
+    {
+        for (auto &entry : values) {
+            if (entry.first == name) return &entry.second;
+        }
+        return nullptr;
+    }
+};
+
+struct obs_data_array {
+    long refs = 1;
+    std::vector<obs_data*> items;
+};
+
+struct obs_source {
+    std::string name;
+    std::string uuid;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    long refs = 1;
+    signal_handler signals;
+    obs_scene *scene = nullptr; // Scenes and groups
+    bool isGroup = false;
+};
+
+struct obs_scene {
+    obs_source *source = nullptr;
+    std::vector<obs_scene_item*> items; // Bottom to top
+};
+
+struct obs_scene_item {
+    int64_t id = 0;
+    obs_scene *parent = nullptr;
+    obs_source *source = nullptr;
+    vec2 pos = {0.0f, 0.0f};
+    vec2 scale = {1.0f, 1.0f};
+    vec2 bounds = {0.0f, 0.0f};
+    uint32_t alignment = OBS_ALIGN_TOP | OBS_ALIGN_LEFT;
+    uint32_t boundsAlignment = OBS_ALIGN_CENTER;
+    obs_bounds_type boundsType = OBS_BOUNDS_NONE;
+    bool visible = true;
+    bool selected = false;
+    obs_data *privateSettings = nullptr;
+    long refs = 1;
+    int deferDepth = 0;
+    bool transformPending = false;
+    uint64_t lastSetterNs = 0;
+};
+
+namespace {
+
+struct TickCallback {
+    void (*tick)(void *, float);
+    void *param;
+};
+
+struct UndoAction {
+    std::string name;
+    undo_redo_cb undo;
+    undo_redo_cb redo;
+    std::string undoData;
+    std::string redoData;
+};
+
+struct World {
+    std::vector<std::unique_ptr<obs_source>> sources;
+    std::vector<std::unique_ptr<obs_scene>> scenes;
+    std::vector<std::unique_ptr<obs_scene_item>> items;
+    signal_handler globalSignals;
+    obs_video_info video = {"fake", 60, 1, 1920, 1080, 1920, 1080};
+    int64_t nextId = 1;
+    uint64_t nextUuid = 1;
+
+    std::mutex tickMutex;
+    std::vector<TickCallback> ticks;
+
+    obs_scene *currentScene = nullptr;
+    std::vector<std::pair<obs_frontend_event_cb, void*>> eventCallbacks;
+    std::vector<std::pair<obs_frontend_save_cb, void*>> saveCallbacks;
+    std::vector<UndoAction> undoStack;
+    size_t undoPos = 0; // Actions [0, undoPos) can be undone
+};
+
+World *world = new World();
+FakeObs::Calls calls;
+
+uint64_t Now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void ReleaseValue(FakeValue &v)
+{
+    if (v.obj) obs_data_release(v.obj);
+    if (v.array) obs_data_array_release(v.array);
+    v.obj = nullptr;
+    v.array = nullptr;
+}
+
+FakeValue &Slot(obs_data_t *data, const char *name)
+{
+    FakeValue *v = data->Find(name);
+    if (v) {
+        ReleaseValue(*v);
+        return *v;
+    }
+    data->values.emplace_back(name, FakeValue());
+    return data->values.back().second;
+}
+
+// ----- JSON (enough for settings and transform states) -----
+
+void WriteJsonString(std::string &out, const std::string &s)
+{
+    out += '"';
+    for (char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default: out += c;
+        }
+    }
+    out += '"';
+}
+
+void WriteJson(std::string &out, obs_data_t *data);
+
+void WriteJsonValue(std::string &out, const FakeValue &v)
+{
+    char number[64];
+    switch (v.type) {
+        case FakeValue::String: WriteJsonString(out, v.s); break;
+        case FakeValue::Int:
+            snprintf(number, sizeof(number), "%lld", v.i);
+            out += number;
+            break;
+        case FakeValue::Double:
+            snprintf(number, sizeof(number), "%.17g", v.d);
+            out += number;
+            break;
+        case FakeValue::Bool: out += v.b ? "true" : "false"; break;
+        case FakeValue::Object: WriteJson(out, v.obj); break;
+        case FakeValue::Array:
+            out += '[';
+            for (size_t i = 0; i < v.array->items.size(); i++) {
+                if (i) out += ',';
+                WriteJson(out, v.array->items[i]);
+            }
+            out += ']';
+            break;
+    }
+}
+
+void WriteJson(std::string &out, obs_data_t *data)
+{
+    out += '{';
+    bool first = true;
+    for (const auto &entry : data->values) {
+        if (!first) out += ',';
+        first = false;
+        WriteJsonString(out, entry.first);
+        out += ':';
+        WriteJsonValue(out, entry.second);
+    }
+    out += '}';
+}
+
+struct JsonParser {
+    const char *p;
+
+    void Skip()
+    {
+        while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t') p++;
+    }
+
+    bool String(std::string &out)
+    {
+        Skip();
+        if (*p != '"') return false;
+        p++;
+        while (*p && *p != '"') {
+            if (*p == '\\') {
+                p++;
+                switch (*p) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    default: out += *p;
+                }
+            } else {
+                out += *p;
+            }
+            p++;
+        }
+        if (*p != '"') return false;
+        p++;
+        return true;
+    }
+
+    bool Value(FakeValue &v)
+    {
+        Skip();
+        if (*p == '"') {
+            v.type = FakeValue::String;
+            return String(v.s);
+        }
+        if (*p == '{') {
+            v.type = FakeValue::Object;
+            v.obj = Object();
+            return v.obj != nullptr;
+        }
+        if (*p == '[') {
+            p++;
+            v.type = FakeValue::Array;
+            v.array = obs_data_array_create();
+            Skip();
+            if (*p == ']') {
+                p++;
+                return true;
+            }
+            for (;;) {
+                obs_data_t *item = Object();
+                if (!item) return false;
+                v.array->items.push_back(item);
+                Skip();
+                if (*p == ',') {
+                    p++;
+                    continue;
+                }
+                if (*p != ']') return false;
+                p++;
+                return true;
+            }
+        }
+        if (!strncmp(p, "true", 4) || !strncmp(p, "false", 5)) {
+            v.type = FakeValue::Bool;
+            v.b = *p == 't';
+            p += v.b ? 4 : 5;
+            return true;
+        }
+
+        char *end = nullptr;
+        const char *start = p;
+        double d = strtod(start, &end);
+        if (end == start) return false;
+        bool integral = std::find_if(start, (const char*)end,
+                                     [](char c) { return c == '.' || c == 'e' || c == 'E'; }) == end;
+        if (integral) {
+            v.type = FakeValue::Int;
+            v.i = strtoll(start, nullptr, 10);
+        } else {
+            v.type = FakeValue::Double;
+            v.d = d;
+        }
+        p = end;
+        return true;
+    }
+
+    obs_data_t *Object()
+    {
+        Skip();
+        if (*p != '{') return nullptr;
+        p++;
+        obs_data_t *data = obs_data_create();
+        Skip();
+        if (*p == '}') {
+            p++;
+            return data;
+        }
+        for (;;) {
+            std::string key;
+            Skip();
+            if (!String(key)) break;
+            Skip();
+            if (*p != ':') break;
+            p++;
+            FakeValue v;
+            if (!Value(v)) {
+                ReleaseValue(v);
+                break;
+            }
+            data->values.emplace_back(key, v);
+            Skip();
+            if (*p == ',') {
+                p++;
+                continue;
+            }
+            if (*p != '}') break;
+            p++;
+            return data;
+        }
+        obs_data_release(data);
+        return nullptr;
+    }
+};
+
+// ----- Items -----
+
+void EmitItem(obs_sceneitem_t *item, const char *signal)
+{
+    calldata cd;
+    cd.ptrs["scene"] = item->parent;
+    cd.ptrs["item"] = item;
+    cd.bools["visible"] = item->visible;
+    item->parent->source->signals.Emit(signal, &cd);
+}
+
+// Group-local box of an item (unrotated bounds or scaled source size)
+void ItemBox(const obs_scene_item *item, float &left, float &top, float &right, float &bottom)
+{
+    float w = item->boundsType != OBS_BOUNDS_NONE ? item->bounds.x : (float)item->source->width * item->scale.x;
+    float h = item->boundsType != OBS_BOUNDS_NONE ? item->bounds.y : (float)item->source->height * item->scale.y;
+    float fx = (item->alignment & OBS_ALIGN_LEFT) ? 0.0f : (item->alignment & OBS_ALIGN_RIGHT) ? 1.0f : 0.5f;
+    float fy = (item->alignment & OBS_ALIGN_TOP) ? 0.0f : (item->alignment & OBS_ALIGN_BOTTOM) ? 1.0f : 0.5f;
+    left = item->pos.x - std::fabs(w) * fx;
+    top = item->pos.y - std::fabs(h) * fy;
+    right = left + std::fabs(w);
+    bottom = top + std::fabs(h);
+}
+
+void Transformed(obs_sceneitem_t *item);
+
+// Like libobs after a child of a group changed: size the group to the
+// children's bounding box and move the box corner to the group origin,
+// shifting the group item so nothing moves on screen
+void FitGroup(obs_scene *scene)
+{
+    if (scene->items.empty()) return;
+
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (obs_scene_item *child : scene->items) {
+        float left, top, right, bottom;
+        ItemBox(child, left, top, right, bottom);
+        minX = std::min(minX, left);
+        minY = std::min(minY, top);
+        maxX = std::max(maxX, right);
+        maxY = std::max(maxY, bottom);
+    }
+
+    bool moved = minX != 0.0f || minY != 0.0f;
+    if (moved) {
+        for (obs_scene_item *child : scene->items) {
+            child->pos.x -= minX;
+            child->pos.y -= minY;
+            EmitItem(child, "item_transform");
+        }
+    }
+
+    uint32_t w = (uint32_t)std::max(1L, std::lround(maxX - minX));
+    uint32_t h = (uint32_t)std::max(1L, std::lround(maxY - minY));
+    bool resized = w != scene->source->width || h != scene->source->height;
+    scene->source->width = w;
+    scene->source->height = h;
+    if (!moved && !resized) return;
+
+    for (auto &group : world->items) {
+        if (group->source != scene->source) continue;
+        group->pos.x += minX * group->scale.x;
+        group->pos.y += minY * group->scale.y;
+        Transformed(group.get());
+    }
+}
+
+void Transformed(obs_sceneitem_t *item)
+{
+    EmitItem(item, "item_transform");
+    if (item->parent->source->isGroup) FitGroup(item->parent);
+}
+
+void TransformChanged(obs_sceneitem_t *item)
+{
+    item->lastSetterNs = Now();
+    if (item->deferDepth > 0) {
+        item->transformPending = true;
+        return;
+    }
+    Transformed(item);
+}
+
+obs_source_t *NewSource(const char *name, uint32_t width, uint32_t height)
+{
+    auto source = std::make_unique<obs_source>();
+    source->name = name;
+    source->uuid = "fake-uuid-" + std::to_string(world->nextUuid++);
+    source->width = width;
+    source->height = height;
+    world->sources.push_back(std::move(source));
+    return world->sources.back().get();
+}
+
+obs_scene_t *NewScene(obs_source_t *source, bool group)
+{
+    auto scene = std::make_unique<obs_scene>();
+    scene->source = source;
+    source->scene = scene.get();
+    source->isGroup = group;
+    world->scenes.push_back(std::move(scene));
+    return world->scenes.back().get();
+}
+
+void SaveItemStates(obs_data_array_t *out, obs_scene_t *scene, bool all)
+{
+    for (obs_scene_item *item : scene->items) {
+        if (all || item->selected) {
+            obs_data_t *state = obs_data_create();
+            obs_data_set_string(state, "scene_uuid", scene->source->uuid.c_str());
+            obs_data_set_int(state, "id", item->id);
+            obs_data_set_double(state, "pos_x", item->pos.x);
+            obs_data_set_double(state, "pos_y", item->pos.y);
+            obs_data_set_double(state, "bounds_x", item->bounds.x);
+            obs_data_set_double(state, "bounds_y", item->bounds.y);
+            obs_data_set_int(state, "alignment", item->alignment);
+            obs_data_set_int(state, "bounds_type", item->boundsType);
+            obs_data_set_int(state, "bounds_alignment", item->boundsAlignment);
+            obs_data_array_push_back(out, state);
+            obs_data_release(state);
+        }
+        if (item->source->isGroup) SaveItemStates(out, item->source->scene, all);
+    }
+}
+
+} // namespace
+
+void signal_handler::Emit(const char *signal, calldata_t *cd)
+{
+    calls.emitted[signal]++;
+
+    auto it = slots.find(signal);
+    if (it == slots.end()) return;
+
+    // Handlers may disconnect while the signal is emitted
+    std::vector<Slot> copy = it->second;
+    for (const Slot &slot : copy) slot.callback(slot.data, cd);
+}
+
+// ===== libobs API =====
+
+extern "C" {
+
+void *bmalloc(size_t size)
+{
+    return malloc(size);
+}
+
+void bfree(void *ptr)
+{
+    free(ptr);
+}
+
+void blogva(int log_level, const char *format, va_list args)
+{
+    if (log_level > LOG_WARNING && !getenv("FAKE_OBS_LOG")) return;
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+}
+
+char *obs_module_config_path(const char *file)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "source-resizer-tests" / file).string();
+    char *out = (char*)bmalloc(path.size() + 1);
+    memcpy(out, path.c_str(), path.size() + 1);
+    return out;
+}
+
+uint64_t os_gettime_ns(void)
+{
+    return Now();
+}
+
+FILE *os_fopen(const char *path, const char *mode)
+{
+    return fopen(path, mode);
+}
+
+int os_mkdirs(const char *path)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(path, ec);
+    return ec ? -1 : 0;
+}
+
+bool obs_get_video_info(struct obs_video_info *ovi)
+{
+    *ovi = world->video;
+    return true;
+}
+
+void obs_add_tick_callback(void (*tick)(void *, float), void *param)
+{
+    std::lock_guard<std::mutex> lock(world->tickMutex);
+    world->ticks.push_back({tick, param});
+}
+
+void obs_remove_tick_callback(void (*tick)(void *, float), void *param)
+{
+    // Like libobs: once this returns the callback is not running
+    std::lock_guard<std::mutex> lock(world->tickMutex);
+    auto &ticks = world->ticks;
+    ticks.erase(std::remove_if(ticks.begin(), ticks.end(),
+                               [&](const TickCallback &t) { return t.tick == tick && t.param == param; }),
+                ticks.end());
+}
+
+signal_handler_t *obs_get_signal_handler(void)
+{
+    return &world->globalSignals;
+}
+
+void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data)
+{
+    handler->slots[signal].push_back({callback, data});
+}
+
+void signal_handler_disconnect(signal_handler_t *handler, const char *signal, signal_callback_t callback,
+                               void *data)
+{
+    auto &slots = handler->slots[signal];
+    for (auto it = slots.begin(); it != slots.end(); ++it) {
+        if (it->callback == callback && it->data == data) {
+            slots.erase(it);
+            return;
+        }
+    }
+}
+
+void *calldata_ptr(const calldata_t *data, const char *name)
+{
+    auto it = data->ptrs.find(name);
+    return it != data->ptrs.end() ? it->second : nullptr;
+}
+
+bool calldata_bool(const calldata_t *data, const char *name)
+{
+    auto it = data->bools.find(name);
+    return it != data->bools.end() && it->second;
+}
+
+obs_source_t *obs_source_get_ref(obs_source_t *source)
+{
+    if (source) source->refs++;
+    return source;
+}
+
+void obs_source_release(obs_source_t *source)
+{
+    if (source) source->refs--;
+}
+
+obs_source_t *obs_get_source_by_uuid(const char *uuid)
+{
+    for (auto &source : world->sources) {
+        if (source->uuid == uuid) return obs_source_get_ref(source.get());
+    }
+    return nullptr;
+}
+
+const char *obs_source_get_name(const obs_source_t *source)
+{
+    return source ? source->name.c_str() : nullptr;
+}
+
+void obs_source_set_name(obs_source_t *source, const char *name)
+{
+    if (source && name) source->name = name;
+}
+
+const char *obs_source_get_uuid(const obs_source_t *source)
+{
+    return source ? source->uuid.c_str() : nullptr;
+}
+
+uint32_t obs_source_get_width(obs_source_t *source)
+{
+    return source ? source->width : 0;
+}
+
+uint32_t obs_source_get_height(obs_source_t *source)
+{
+    return source ? source->height : 0;
+}
+
+signal_handler_t *obs_source_get_signal_handler(const obs_source_t *source)
+{
+    return source ? const_cast<signal_handler*>(&source->signals) : nullptr;
+}
+
+void obs_enum_scenes(bool (*enum_proc)(void *, obs_source_t *), void *param)
+{
+    for (auto &scene : world->scenes) {
+        if (!scene->source->isGroup && !enum_proc(param, scene->source)) return;
+    }
+}
+
+obs_scene_t *obs_scene_from_source(const obs_source_t *source)
+{
+    return source && !source->isGroup ? source->scene : nullptr;
+}
+
+obs_scene_t *obs_group_from_source(const obs_source_t *source)
+{
+    return source && source->isGroup ? source->scene : nullptr;
+}
+
+obs_scene_t *obs_group_or_scene_from_source(const obs_source_t *source)
+{
+    return source ? source->scene : nullptr;
+}
+
+obs_source_t *obs_scene_get_source(const obs_scene_t *scene)
+{
+    return scene ? scene->source : nullptr;
+}
+
+obs_scene_t *obs_scene_get_ref(obs_scene_t *scene)
+{
+    if (scene) obs_source_get_ref(scene->source);
+    return scene;
+}
+
+void obs_scene_release(obs_scene_t *scene)
+{
+    if (scene) obs_source_release(scene->source);
+}
+
+void obs_scene_enum_items(obs_scene_t *scene, obs_scene_enum_cb callback, void *param)
+{
+    if (!scene) return;
+    calls.enumItems++;
+    for (obs_scene_item *item : scene->items) {
+        if (!callback(scene, item, param)) return;
+    }
+}
+
+obs_sceneitem_t *obs_scene_find_sceneitem_by_id(obs_scene_t *scene, int64_t id)
+{
+    if (!scene) return nullptr;
+    for (obs_scene_item *item : scene->items) {
+        if (item->id == id) return item;
+    }
+    return nullptr;
+}
+
+obs_data_t *obs_scene_save_transform_states(obs_scene_t *scene, bool all_items)
+{
+    obs_data_t *data = obs_data_create();
+    obs_data_array_t *items = obs_data_array_create();
+    SaveItemStates(items, scene, all_items);
+    obs_data_set_string(data, "scene_uuid", scene->source->uuid.c_str());
+    obs_data_set_array(data, "items_info", items);
+    obs_data_array_release(items);
+    return data;
+}
+
+void obs_scene_load_transform_states(const char *state)
+{
+    obs_data_t *data = obs_data_create_from_json(state);
+    if (!data) return;
+
+    obs_data_array_t *items = obs_data_get_array(data, "items_info");
+    for (size_t i = 0; i < obs_data_array_count(items); i++) {
+        obs_data_t *entry = obs_data_array_item(items, i);
+        obs_source_t *source = obs_get_source_by_uuid(obs_data_get_string(entry, "scene_uuid"));
+        obs_scene_t *scene = obs_group_or_scene_from_source(source);
+        obs_sceneitem_t *item = obs_scene_find_sceneitem_by_id(scene, obs_data_get_int(entry, "id"));
+        if (item) {
+            vec2 pos = {(float)obs_data_get_double(entry, "pos_x"), (float)obs_data_get_double(entry, "pos_y")};
+            vec2 bounds = {(float)obs_data_get_double(entry, "bounds_x"),
+                           (float)obs_data_get_double(entry, "bounds_y")};
+            obs_sceneitem_defer_update_begin(item);
+            obs_sceneitem_set_pos(item, &pos);
+            obs_sceneitem_set_bounds(item, &bounds);
+            obs_sceneitem_set_alignment(item, (uint32_t)obs_data_get_int(entry, "alignment"));
+            obs_sceneitem_set_bounds_type(item, (obs_bounds_type)obs_data_get_int(entry, "bounds_type"));
+            obs_sceneitem_set_bounds_alignment(item, (uint32_t)obs_data_get_int(entry, "bounds_alignment"));
+            obs_sceneitem_defer_update_end(item);
+        }
+        obs_source_release(source);
+        obs_data_release(entry);
+    }
+    obs_data_array_release(items);
+    obs_data_release(data);
+}
+
+void obs_sceneitem_addref(obs_sceneitem_t *item)
+{
+    if (item) item->refs++;
+}
+
+void obs_sceneitem_release(obs_sceneitem_t *item)
+{
+    if (item) item->refs--;
+}
+
+int64_t obs_sceneitem_get_id(const obs_sceneitem_t *item)
+{
+    return item->id;
+}
+
+obs_scene_t *obs_sceneitem_get_scene(const obs_sceneitem_t *item)
+{
+    return item ? item->parent : nullptr;
+}
+
+obs_source_t *obs_sceneitem_get_source(const obs_sceneitem_t *item)
+{
+    return item ? item->source : nullptr;
+}
+
+bool obs_sceneitem_selected(const obs_sceneitem_t *item)
+{
+    return item && item->selected;
+}
+
+bool obs_sceneitem_is_group(obs_sceneitem_t *item)
+{
+    return item && item->source->isGroup;
+}
+
+obs_scene_t *obs_sceneitem_group_get_scene(const obs_sceneitem_t *group)
+{
+    return group && group->source->isGroup ? group->source->scene : nullptr;
+}
+
+bool obs_sceneitem_visible(const obs_sceneitem_t *item)
+{
+    return item && item->visible;
+}
+
+bool obs_sceneitem_set_visible(obs_sceneitem_t *item, bool visible)
+{
+    calls.setVisible++;
+    item->visible = visible;
+    EmitItem(item, "item_visible");
+    return true;
+}
+
+void obs_sceneitem_set_pos(obs_sceneitem_t *item, const struct vec2 *pos)
+{
+    calls.setPos++;
+    item->pos = *pos;
+    TransformChanged(item);
+}
+
+void obs_sceneitem_get_pos(const obs_sceneitem_t *item, struct vec2 *pos)
+{
+    *pos = item->pos;
+}
+
+void obs_sceneitem_get_scale(const obs_sceneitem_t *item, struct vec2 *scale)
+{
+    *scale = item->scale;
+}
+
+void obs_sceneitem_set_alignment(obs_sceneitem_t *item, uint32_t alignment)
+{
+    calls.setAlignment++;
+    item->alignment = alignment;
+    TransformChanged(item);
+}
+
+uint32_t obs_sceneitem_get_alignment(const obs_sceneitem_t *item)
+{
+    return item->alignment;
+}
+
+void obs_sceneitem_set_bounds_type(obs_sceneitem_t *item, enum obs_bounds_type type)
+{
+    calls.setBoundsType++;
+    item->boundsType = type;
+    TransformChanged(item);
+}
+
+enum obs_bounds_type obs_sceneitem_get_bounds_type(const obs_sceneitem_t *item)
+{
+    return item->boundsType;
+}
+
+void obs_sceneitem_set_bounds_alignment(obs_sceneitem_t *item, uint32_t alignment)
+{
+    calls.setBoundsAlignment++;
+    item->boundsAlignment = alignment;
+    TransformChanged(item);
+}
+
+uint32_t obs_sceneitem_get_bounds_alignment(const obs_sceneitem_t *item)
+{
+    return item->boundsAlignment;
+}
+
+void obs_sceneitem_set_bounds(obs_sceneitem_t *item, const struct vec2 *bounds)
+{
+    calls.setBounds++;
+    item->bounds = *bounds;
+    TransformChanged(item);
+}
+
+void obs_sceneitem_get_bounds(const obs_sceneitem_t *item, struct vec2 *bounds)
+{
+    *bounds = item->bounds;
+}
+
+obs_data_t *obs_sceneitem_get_private_settings(obs_sceneitem_t *item)
+{
+    calls.privateSettings++;
+    obs_data_addref(item->privateSettings);
+    return item->privateSettings;
+}
+
+void obs_sceneitem_defer_update_begin(obs_sceneitem_t *item)
+{
+    calls.deferBegin++;
+    item->deferDepth++;
+}
+
+void obs_sceneitem_defer_update_end(obs_sceneitem_t *item)
+{
+    if (--item->deferDepth > 0 || !item->transformPending) return;
+    item->transformPending = false;
+    Transformed(item);
+}
+
+obs_data_t *obs_data_create(void)
+{
+    return new obs_data();
+}
+
+obs_data_t *obs_data_create_from_json(const char *json_string)
+{
+    if (!json_string) return nullptr;
+    JsonParser parser{json_string};
+    return parser.Object();
+}
+
+void obs_data_addref(obs_data_t *data)
+{
+    if (data) data->refs++;
+}
+
+void obs_data_release(obs_data_t *data)
+{
+    if (!data || --data->refs > 0) return;
+    for (auto &entry : data->values) ReleaseValue(entry.second);
+    delete data;
+}
+
+const char *obs_data_get_json(obs_data_t *data)
+{
+    data->json.clear();
+    WriteJson(data->json, data);
+    return data->json.c_str();
+}
+
+bool obs_data_has_user_value(obs_data_t *data, const char *name)
+{
+    return data->Find(name) != nullptr;
+}
+
+void obs_data_erase(obs_data_t *data, const char *name)
+{
+    auto &values = data->values;
+    for (auto it = values.begin(); it != values.end(); ++it) {
+        if (it->first == name) {
+            ReleaseValue(it->second);
+            values.erase(it);
+            return;
+        }
+    }
+}
+
+void obs_data_set_string(obs_data_t *data, const char *name, const char *val)
+{
+    FakeValue &v = Slot(data, name);
+    v.type = FakeValue::String;
+    v.s = val ? val : "";
+}
+
+void obs_data_set_int(obs_data_t *data, const char *name, long long val)
+{
+    FakeValue &v = Slot(data, name);
+    v.type = FakeValue::Int;
+    v.i = val;
+}
+
+void obs_data_set_double(obs_data_t *data, const char *name, double val)
+{
+    FakeValue &v = Slot(data, name);
+    v.type = FakeValue::Double;
+    v.d = val;
+}
+
+void obs_data_set_obj(obs_data_t *data, const char *name, obs_data_t *obj)
+{
+    FakeValue &v = Slot(data, name);
+    v.type = FakeValue::Object;
+    obs_data_addref(obj);
+    v.obj = obj;
+}
+
+void obs_data_set_array(obs_data_t *data, const char *name, obs_data_array_t *array)
+{
+    FakeValue &v = Slot(data, name);
+    v.type = FakeValue::Array;
+    if (array) array->refs++;
+    v.array = array;
+}
+
+const char *obs_data_get_string(obs_data_t *data, const char *name)
+{
+    FakeValue *v = data->Find(name);
+    return v && v->type == FakeValue::String ? v->s.c_str() : "";
+}
+
+long long obs_data_get_int(obs_data_t *data, const char *name)
+{
+    FakeValue *v = data->Find(name);
+    if (!v) return 0;
+    return v->type == FakeValue::Double ? (long long)v->d : v->i;
+}
+
+double obs_data_get_double(obs_data_t *data, const char *name)
+{
+    FakeValue *v = data->Find(name);
+    if (!v) return 0.0;
+    return v->type == FakeValue::Int ? (double)v->i : v->d;
+}
+
+obs_data_t *obs_data_get_obj(obs_data_t *data, const char *name)
+{
+    FakeValue *v = data->Find(name);
+    if (!v || v->type != FakeValue::Object) return nullptr;
+    obs_data_addref(v->obj);
+    return v->obj;
+}
+
+obs_data_array_t *obs_data_get_array(obs_data_t *data, const char *name)
+{
+    FakeValue *v = data->Find(name);
+    if (!v || v->type != FakeValue::Array || !v->array) return nullptr;
+    v->array->refs++;
+    return v->array;
+}
+
+obs_data_array_t *obs_data_array_create(void)
+{
+    return new obs_data_array();
+}
+
+void obs_data_array_release(obs_data_array_t *array)
+{
+    if (!array || --array->refs > 0) return;
+    for (obs_data *item : array->items) obs_data_release(item);
+    delete array;
+}
+
+size_t obs_data_array_count(obs_data_array_t *array)
+{
+    return array ? array->items.size() : 0;
+}
+
+obs_data_t *obs_data_array_item(obs_data_array_t *array, size_t idx)
+{
+    if (!array || idx >= array->items.size()) return nullptr;
+    obs_data_addref(array->items[idx]);
+    return array->items[idx];
+}
+
+size_t obs_data_array_push_back(obs_data_array_t *array, obs_data_t *obj)
+{
+    obs_data_addref(obj);
+    array->items.push_back(obj);
+    return array->items.size() - 1;
+}
+
+// ===== Frontend API =====
+
+void obs_frontend_add_event_callback(obs_frontend_event_cb callback, void *private_data)
+{
+    world->eventCallbacks.emplace_back(callback, private_data);
+}
+
+void obs_frontend_remove_event_callback(obs_frontend_event_cb callback, void *private_data)
+{
+    auto &cbs = world->eventCallbacks;
+    cbs.erase(std::remove(cbs.begin(), cbs.end(), std::make_pair(callback, private_data)), cbs.end());
+}
+
+void obs_frontend_add_save_callback(obs_frontend_save_cb callback, void *private_data)
+{
+    world->saveCallbacks.emplace_back(callback, private_data);
+}
+
+void obs_frontend_remove_save_callback(obs_frontend_save_cb callback, void *private_data)
+{
+    auto &cbs = world->saveCallbacks;
+    cbs.erase(std::remove(cbs.begin(), cbs.end(), std::make_pair(callback, private_data)), cbs.end());
+}
+
+obs_source_t *obs_frontend_get_current_scene(void)
+{
+    return world->currentScene ? obs_source_get_ref(world->currentScene->source) : nullptr;
+}
+
+bool obs_frontend_add_dock_by_id(const char *, const char *, void *)
+{
+    return true;
+}
+
+void obs_frontend_add_tools_menu_item(const char *, obs_frontend_cb, void *) {}
+
+void *obs_frontend_add_tools_menu_qaction(const char *)
+{
+    return nullptr;
+}
+
+void obs_frontend_add_undo_redo_action(const char *name, const undo_redo_cb undo, const undo_redo_cb redo,
+                                       const char *undo_data, const char *redo_data, bool)
+{
+    // A new action drops everything that was undone
+    world->undoStack.resize(world->undoPos);
+    world->undoStack.push_back({name, undo, redo, undo_data, redo_data});
+    world->undoPos = world->undoStack.size();
+}
+
+} // extern "C"
+
+// ===== Test control =====
+
+namespace FakeObs {
+
+Calls &GetCalls()
+{
+    return calls;
+}
+
+void ResetCalls()
+{
+    calls = Calls();
+}
+
+void Reset()
+{
+    for (auto &item : world->items) obs_data_release(item->privateSettings);
+    delete world;
+    world = new World();
+    ResetCalls();
+}
+
+void SetCanvas(uint32_t width, uint32_t height, uint32_t fps)
+{
+    world->video.base_width = world->video.output_width = width;
+    world->video.base_height = world->video.output_height = height;
+    world->video.fps_num = fps;
+    world->video.fps_den = 1;
+
+    calldata cd;
+    world->globalSignals.Emit("video_reset", &cd);
+}
+
+obs_source_t *CreateSource(const char *name, uint32_t width, uint32_t height)
+{
+    return NewSource(name, width, height);
+}
+
+obs_scene_t *CreateScene(const char *name)
+{
+    return NewScene(NewSource(name, world->video.base_width, world->video.base_height), false);
+}
+
+obs_sceneitem_t *AddItem(obs_scene_t *scene, obs_source_t *source)
+{
+    auto item = std::make_unique<obs_scene_item>();
+    item->id = world->nextId++;
+    item->parent = scene;
+    item->source = source;
+    item->privateSettings = obs_data_create();
+    source->refs++;
+
+    obs_scene_item *raw = item.get();
+    world->items.push_back(std::move(item));
+    scene->items.push_back(raw);
+
+    EmitItem(raw, "item_add");
+    return raw;
+}
+
+obs_sceneitem_t *AddGroup(obs_scene_t *scene, const char *name, uint32_t width, uint32_t height)
+{
+    obs_source_t *source = NewSource(name, width, height);
+    NewScene(source, true);
+    return AddItem(scene, source);
+}
+
+void SetSourceSize(obs_source_t *source, uint32_t width, uint32_t height)
+{
+    source->width = width;
+    source->height = height;
+}
+
+void Select(obs_sceneitem_t *item, bool selected)
+{
+    if (item->selected == selected) return;
+    item->selected = selected;
+    EmitItem(item, selected ? "item_select" : "item_deselect");
+}
+
+long ItemRefs(obs_sceneitem_t *item)
+{
+    return item->refs;
+}
+
+long SourceRefs(obs_source_t *source)
+{
+    return source->refs;
+}
+
+uint64_t LastSetterNs(obs_sceneitem_t *item)
+{
+    return item->lastSetterNs;
+}
+
+void Tick(float seconds)
+{
+    std::lock_guard<std::mutex> lock(world->tickMutex);
+    for (const TickCallback &t : world->ticks) t.tick(t.param, seconds);
+}
+
+size_t TickCallbacks()
+{
+    std::lock_guard<std::mutex> lock(world->tickMutex);
+    return world->ticks.size();
+}
+
+void SetCurrentScene(obs_scene_t *scene)
+{
+    world->currentScene = scene;
+    SendFrontendEvent(OBS_FRONTEND_EVENT_SCENE_CHANGED);
+}
+
+void SendFrontendEvent(enum obs_frontend_event event)
+{
+    auto cbs = world->eventCallbacks;
+    for (const auto &cb : cbs) cb.first(event, cb.second);
+}
+
+void Save()
+{
+    obs_data_t *data = obs_data_create();
+    auto cbs = world->saveCallbacks;
+    for (const auto &cb : cbs) cb.first(data, true, cb.second);
+    obs_data_release(data);
+}
+
+size_t UndoCount()
+{
+    return world->undoPos;
+}
+
+bool Undo()
+{
+    if (!world->undoPos) return false;
+    const UndoAction &action = world->undoStack[--world->undoPos];
+    action.undo(action.undoData.c_str());
+    return true;
+}
+
+bool Redo()
+{
+    if (world->undoPos == world->undoStack.size()) return false;
+    const UndoAction &action = world->undoStack[world->undoPos++];
+    action.redo(action.redoData.c_str());
+    return true;
+}
+
+Synthetic BuildScene(size_t items, size_t groups, size_t depth)
+{
+    Synthetic out;
+    out.scene = CreateScene("synthetic");
+
+    // Groups nest 'depth' levels: group i sits in group i - 1 unless it starts a new chain
+    std::vector<obs_scene_t*> containers = {out.scene};
+    for (size_t g = 0; g < groups; g++) {
+        obs_scene_t *parent = (depth > 1 && g % depth != 0) ? containers.back() : out.scene;
+        std::string name = "group " + std::to_string(g);
+        obs_sceneitem_t *group = AddGroup(parent, name.c_str(), 400, 300);
+        out.groups.push_back(group);
+        containers.push_back(group->source->scene);
+    }
+
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < items; i++) {
+        std::string name = "item " + std::to_string(i);
+        obs_sceneitem_t *item = AddItem(containers[i % containers.size()], CreateSource(name.c_str(), 100, 100));
+        seed = seed * 1664525u + 1013904223u;
+        item->pos = {(float)(seed % 1800), (float)((seed >> 12) % 1000)};
+        out.items.push_back(item);
+    }
+    return out;
+}
+
+} // namespace FakeObs
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <obs.h>
+#include <obs-frontend-api.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Test-side control of the fake libobs
+ *
+ * Everything lives in memory until Reset(): sources, scenes, items and
+ * their private settings. Objects are never freed before that, so tests
+ * can check reference counts after the code under test released them.
+ *
+ * Setters behave like libobs: they always store the value and emit
+ * item_transform on the parent scene (once at defer_update_end while an
+ * update is deferred). After a child of a group changed, the group is
+ * fitted to its children's bounding box and the box corner moved to the
+ * group origin, as libobs does. Every call is counted, so tests can
+ * assert which setters ran, and every signal emitted (scene and global
+ * handlers) is counted by name. Single-threaded except for Tick(), which
+ * may be called from any one thread at a time.
+ */
+namespace FakeObs {
+
+struct Calls {
+    uint64_t setPos = 0;
+    uint64_t setBounds = 0;
+    uint64_t setBoundsType = 0;
+    uint64_t setBoundsAlignment = 0;
+    uint64_t setAlignment = 0;
+    uint64_t setVisible = 0;
+    uint64_t deferBegin = 0;
+    uint64_t enumItems = 0;       // obs_scene_enum_items (one scene mutex acquisition each)
+    uint64_t privateSettings = 0;  // obs_sceneitem_get_private_settings
+    std::map<std::string, uint64_t> emitted; // Emissions per signal name, connected or not
+
+    uint64_t Signals(const char *name) const
+    {
+        auto it = emitted.find(name);
+        return it == emitted.end() ? 0 : it->second;
+    }
+
+    uint64_t Setters() const
+    {
+        return setPos + setBounds + setBoundsType + setBoundsAlignment + setAlignment + setVisible;
+    }
+};
+
+/** Counters since the last ResetCalls() */
+Calls &GetCalls();
+void ResetCalls();
+
+/** Drop every object and callback, reset the canvas to 1920x1080 @ 60 fps */
+void Reset();
+
+void SetCanvas(uint32_t width, uint32_t height, uint32_t fps = 60);
+
+/** Create objects (the fake keeps them; returned pointers are not referenced) */
+obs_source_t *CreateSource(const char *name, uint32_t width, uint32_t height);
+obs_scene_t *CreateScene(const char *name);
+obs_sceneitem_t *AddItem(obs_scene_t *scene, obs_source_t *source);
+obs_sceneitem_t *AddGroup(obs_scene_t *scene, const char *name, uint32_t width, uint32_t height);
+
+/** Group contents / source size (no signals, like a source resizing itself) */
+void SetSourceSize(obs_source_t *source, uint32_t width, uint32_t height);
+
+/** Emits item_select / item_deselect on the item's scene */
+void Select(obs_sceneitem_t *item, bool selected);
+
+/** Current reference count (1 = only the owning scene) */
+long ItemRefs(obs_sceneitem_t *item);
+long SourceRefs(obs_source_t *source);
+
+/** os_gettime_ns of the last setter call on 'item' (0 = none) */
+uint64_t LastSetterNs(obs_sceneitem_t *item);
+
+/** Run the tick callbacks once (the graphics thread's per-frame tick) */
+void Tick(float seconds = 1.0f / 60.0f);
+size_t TickCallbacks();
+
+/** Frontend */
+void SetCurrentScene(obs_scene_t *scene);
+void SendFrontendEvent(enum obs_frontend_event event);
+void Save();
+size_t UndoCount();
+bool Undo();
+bool Redo();
+
+/**
+ * Synthetic scene: 'items' sources spread round-robin over the root and
+ * 'groups' groups (nested 'depth' levels deep), every item 100x100 at a
+ * pseudo-random position. Items are listed in creation order.
+ */
+struct Synthetic {
+    obs_scene_t *scene = nullptr;
+    std::vector<obs_sceneitem_t*> items;
+    std::vector<obs_sceneitem_t*> groups;
+};
+Synthetic BuildScene(size_t items, size_t groups = 0, size_t depth = 1);
+
+} // namespace FakeObs
@@ -0,0 +1,39 @@
+/* Fake libobs: obs-frontend-api subset (see obs.h) */
+
+#pragma once
+
+#include <obs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum obs_frontend_event {
+    OBS_FRONTEND_EVENT_SCENE_CHANGED,
+    OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING,
+    OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED,
+    OBS_FRONTEND_EVENT_SCENE_COLLECTION_CLEANUP,
+    OBS_FRONTEND_EVENT_FINISHED_LOADING,
+    OBS_FRONTEND_EVENT_SCRIPTING_SHUTDOWN,
+    OBS_FRONTEND_EVENT_EXIT,
+};
+
+typedef void (*obs_frontend_event_cb)(enum obs_frontend_event event, void *private_data);
+typedef void (*obs_frontend_save_cb)(obs_data_t *save_data, bool saving, void *private_data);
+typedef void (*obs_frontend_cb)(void *private_data);
+typedef void (*undo_redo_cb)(const char *data);
+
+void obs_frontend_add_event_callback(obs_frontend_event_cb callback, void *private_data);
+void obs_frontend_remove_event_callback(obs_frontend_event_cb callback, void *private_data);
+void obs_frontend_add_save_callback(obs_frontend_save_cb callback, void *private_data);
+void obs_frontend_remove_save_callback(obs_frontend_save_cb callback, void *private_data);
+obs_source_t *obs_frontend_get_current_scene(void);
+bool obs_frontend_add_dock_by_id(const char *id, const char *title, void *widget);
+void obs_frontend_add_tools_menu_item(const char *name, obs_frontend_cb callback, void *private_data);
+void *obs_frontend_add_tools_menu_qaction(const char *name);
+void obs_frontend_add_undo_redo_action(const char *name, const undo_redo_cb undo, const undo_redo_cb redo,
+                                       const char *undo_data, const char *redo_data, bool repeatable);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,16 @@
+/* Fake libobs: module API (see obs.h) */
+
+#pragma once
+
+#include <obs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Paths under the fake module's config directory (bfree the result) */
+char *obs_module_config_path(const char *file);
+
+#ifdef __cplusplus
+}
+#endif
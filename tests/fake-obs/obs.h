@@ -0,0 +1,159 @@
+/*
+ * Fake libobs for the headless tests and benchmarks
+ *
+ * Declares the subset of the libobs API the plugin uses, with the same
+ * names and signatures, so the plugin sources compile unchanged against
+ * it. fake-obs.cpp implements it in memory (scenes, items, obs_data,
+ * signals, tick callbacks); fake-obs.hpp is the test-side control API.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct obs_source obs_source_t;
+typedef struct obs_scene obs_scene_t;
+typedef struct obs_scene_item obs_sceneitem_t;
+typedef struct obs_data obs_data_t;
+typedef struct obs_data_array obs_data_array_t;
+typedef struct signal_handler signal_handler_t;
+typedef struct calldata calldata_t;
+
+struct vec2 {
+    float x, y;
+};
+
+struct obs_video_info {
+    const char *graphics_module;
+    uint32_t fps_num;
+    uint32_t fps_den;
+    uint32_t base_width;
+    uint32_t base_height;
+    uint32_t output_width;
+    uint32_t output_height;
+};
+
+enum obs_bounds_type {
+    OBS_BOUNDS_NONE,
+    OBS_BOUNDS_STRETCH,
+    OBS_BOUNDS_SCALE_INNER,
+    OBS_BOUNDS_SCALE_OUTER,
+    OBS_BOUNDS_SCALE_TO_WIDTH,
+    OBS_BOUNDS_SCALE_TO_HEIGHT,
+    OBS_BOUNDS_MAX_ONLY,
+};
+
+#define OBS_ALIGN_CENTER (0)
+#define OBS_ALIGN_LEFT (1 << 0)
+#define OBS_ALIGN_RIGHT (1 << 1)
+#define OBS_ALIGN_TOP (1 << 2)
+#define OBS_ALIGN_BOTTOM (1 << 3)
+
+#define LOG_ERROR 100
+#define LOG_WARNING 200
+#define LOG_INFO 300
+#define LOG_DEBUG 400
+
+typedef void (*signal_callback_t)(void *data, calldata_t *cd);
+typedef bool (*obs_scene_enum_cb)(obs_scene_t *scene, obs_sceneitem_t *item, void *param);
+
+/* Memory */
+void *bmalloc(size_t size);
+void bfree(void *ptr);
+
+/* Video */
+bool obs_get_video_info(struct obs_video_info *ovi);
+void obs_add_tick_callback(void (*tick)(void *param, float seconds), void *param);
+void obs_remove_tick_callback(void (*tick)(void *param, float seconds), void *param);
+
+/* Signals */
+signal_handler_t *obs_get_signal_handler(void);
+void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data);
+void signal_handler_disconnect(signal_handler_t *handler, const char *signal, signal_callback_t callback,
+                               void *data);
+void *calldata_ptr(const calldata_t *data, const char *name);
+bool calldata_bool(const calldata_t *data, const char *name);
+
+/* Sources */
+obs_source_t *obs_source_get_ref(obs_source_t *source);
+void obs_source_release(obs_source_t *source);
+obs_source_t *obs_get_source_by_uuid(const char *uuid);
+const char *obs_source_get_name(const obs_source_t *source);
+void obs_source_set_name(obs_source_t *source, const char *name);
+const char *obs_source_get_uuid(const obs_source_t *source);
+uint32_t obs_source_get_width(obs_source_t *source);
+uint32_t obs_source_get_height(obs_source_t *source);
+signal_handler_t *obs_source_get_signal_handler(const obs_source_t *source);
+void obs_enum_scenes(bool (*enum_proc)(void *param, obs_source_t *source), void *param);
+
+/* Scenes */
+obs_scene_t *obs_scene_from_source(const obs_source_t *source);
+obs_scene_t *obs_group_from_source(const obs_source_t *source);
+obs_scene_t *obs_group_or_scene_from_source(const obs_source_t *source);
+obs_source_t *obs_scene_get_source(const obs_scene_t *scene);
+obs_scene_t *obs_scene_get_ref(obs_scene_t *scene);
+void obs_scene_release(obs_scene_t *scene);
+void obs_scene_enum_items(obs_scene_t *scene, obs_scene_enum_cb callback, void *param);
+obs_sceneitem_t *obs_scene_find_sceneitem_by_id(obs_scene_t *scene, int64_t id);
+obs_data_t *obs_scene_save_transform_states(obs_scene_t *scene, bool all_items);
+void obs_scene_load_transform_states(const char *state);
+
+/* Scene items */
+void obs_sceneitem_addref(obs_sceneitem_t *item);
+void obs_sceneitem_release(obs_sceneitem_t *item);
+int64_t obs_sceneitem_get_id(const obs_sceneitem_t *item);
+obs_scene_t *obs_sceneitem_get_scene(const obs_sceneitem_t *item);
+obs_source_t *obs_sceneitem_get_source(const obs_sceneitem_t *item);
+bool obs_sceneitem_selected(const obs_sceneitem_t *item);
+bool obs_sceneitem_is_group(obs_sceneitem_t *item);
+obs_scene_t *obs_sceneitem_group_get_scene(const obs_sceneitem_t *group);
+bool obs_sceneitem_visible(const obs_sceneitem_t *item);
+bool obs_sceneitem_set_visible(obs_sceneitem_t *item, bool visible);
+void obs_sceneitem_set_pos(obs_sceneitem_t *item, const struct vec2 *pos);
+void obs_sceneitem_get_pos(const obs_sceneitem_t *item, struct vec2 *pos);
+void obs_sceneitem_get_scale(const obs_sceneitem_t *item, struct vec2 *scale);
+void obs_sceneitem_set_alignment(obs_sceneitem_t *item, uint32_t alignment);
+uint32_t obs_sceneitem_get_alignment(const obs_sceneitem_t *item);
+void obs_sceneitem_set_bounds_type(obs_sceneitem_t *item, enum obs_bounds_type type);
+enum obs_bounds_type obs_sceneitem_get_bounds_type(const obs_sceneitem_t *item);
+void obs_sceneitem_set_bounds_alignment(obs_sceneitem_t *item, uint32_t alignment);
+uint32_t obs_sceneitem_get_bounds_alignment(const obs_sceneitem_t *item);
+void obs_sceneitem_set_bounds(obs_sceneitem_t *item, const struct vec2 *bounds);
+void obs_sceneitem_get_bounds(const obs_sceneitem_t *item, struct vec2 *bounds);
+obs_data_t *obs_sceneitem_get_private_settings(obs_sceneitem_t *item);
+void obs_sceneitem_defer_update_begin(obs_sceneitem_t *item);
+void obs_sceneitem_defer_update_end(obs_sceneitem_t *item);
+
+/* Settings data */
+obs_data_t *obs_data_create(void);
+obs_data_t *obs_data_create_from_json(const char *json_string);
+void obs_data_addref(obs_data_t *data);
+void obs_data_release(obs_data_t *data);
+const char *obs_data_get_json(obs_data_t *data);
+bool obs_data_has_user_value(obs_data_t *data, const char *name);
+void obs_data_erase(obs_data_t *data, const char *name);
+void obs_data_set_string(obs_data_t *data, const char *name, const char *val);
+void obs_data_set_int(obs_data_t *data, const char *name, long long val);
+void obs_data_set_double(obs_data_t *data, const char *name, double val);
+void obs_data_set_obj(obs_data_t *data, const char *name, obs_data_t *obj);
+void obs_data_set_array(obs_data_t *data, const char *name, obs_data_array_t *array);
+const char *obs_data_get_string(obs_data_t *data, const char *name);
+long long obs_data_get_int(obs_data_t *data, const char *name);
+double obs_data_get_double(obs_data_t *data, const char *name);
+obs_data_t *obs_data_get_obj(obs_data_t *data, const char *name);
+obs_data_array_t *obs_data_get_array(obs_data_t *data, const char *name);
+obs_data_array_t *obs_data_array_create(void);
+void obs_data_array_release(obs_data_array_t *array);
+size_t obs_data_array_count(obs_data_array_t *array);
+obs_data_t *obs_data_array_item(obs_data_array_t *array, size_t idx);
+size_t obs_data_array_push_back(obs_data_array_t *array, obs_data_t *obj);
+
+#ifdef __cplusplus
+}
+#endif
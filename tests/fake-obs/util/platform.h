@@ -0,0 +1,18 @@
+/* Fake libobs: util/platform.h subset (see obs.h) */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t os_gettime_ns(void);
+FILE *os_fopen(const char *path, const char *mode);
+int os_mkdirs(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
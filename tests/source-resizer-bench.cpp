@@ -0,0 +1,330 @@
+/*
+ * Micro-benchmarks of the RectTransform hot paths against the fake libobs
+ *
+ *   source-resizer-bench [--max-items N] [--min-time-ms T] [--out FILE]
+ *
+ * Sweeps 1..100k items (powers of ten up to --max-items) and prints one
+ * JSON document: per case and item count, the median and best time per
+ * item over repeated samples of at least --min-time-ms in total. Inputs are
+ * pseudo-random but fixed, so runs are comparable between builds.
+ */
+
+#include <fake-obs.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include "rect-transform.hpp"
+
+namespace {
+
+const uint32_t canvasW = 1920;
+const uint32_t canvasH = 1080;
+
+volatile float sink; // Keeps results alive
+
+struct Result {
+    std::string name;
+    size_t items;
+    size_t samples;
+    double medianNs; // Per item
+    double bestNs;
+};
+
+struct Rng {
+    uint32_t state = 0x12345678u;
+
+    uint32_t Next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    float Range(float lo, float hi) { return lo + (hi - lo) * (float)(Next() & 0xffffff) / (float)0x1000000; }
+};
+
+// Every preset (fixed and stretched axes) with random offsets and sizes
+std::vector<RectTransform> MakeTransforms(size_t n)
+{
+    Rng rng;
+    std::vector<RectTransform> out(n);
+    for (size_t i = 0; i < n; i++) {
+        const AnchorPreset &p = anchorPresets[i % 4][(i / 4) % 4];
+        RectTransform &rt = out[i];
+        rt.anchorMinX = p.minX;
+        rt.anchorMinY = p.minY;
+        rt.anchorMaxX = p.maxX;
+        rt.anchorMaxY = p.maxY;
+        rt.pivotX = p.pivotX;
+        rt.pivotY = p.pivotY;
+        rt.anchoredPosX = rng.Range(-500.0f, 500.0f);
+        rt.anchoredPosY = rng.Range(-500.0f, 500.0f);
+        rt.sizeDeltaX = rt.IsStretchX() ? rng.Range(-100.0f, 0.0f) : rng.Range(10.0f, 800.0f);
+        rt.sizeDeltaY = rt.IsStretchY() ? rng.Range(-100.0f, 0.0f) : rng.Range(10.0f, 600.0f);
+    }
+    return out;
+}
+
+// The per-field keys used before "rt_state" (see RectTransform::LoadAnchors)
+const char *legacyKeys[] = {
+    "rt_anchorMinX", "rt_anchorMinY", "rt_anchorMaxX", "rt_anchorMaxY", "rt_pivotX",
+    "rt_pivotY", "rt_anchoredPosX", "rt_anchoredPosY", "rt_sizeDeltaX", "rt_sizeDeltaY",
+};
+
+void SetLegacyKeys(obs_data_t *settings, const RectTransform &rt)
+{
+    const float fields[] = {
+        rt.anchorMinX, rt.anchorMinY, rt.anchorMaxX, rt.anchorMaxY, rt.pivotX,
+        rt.pivotY, rt.anchoredPosX, rt.anchoredPosY, rt.sizeDeltaX, rt.sizeDeltaY,
+    };
+    for (size_t i = 0; i < 10; i++) obs_data_set_double(settings, legacyKeys[i], fields[i]);
+}
+
+// One item's private settings as written to the collection file
+std::string SettingsJson(const RectTransform &rt, bool legacy)
+{
+    obs_data_t *settings = obs_data_create();
+    if (legacy) SetLegacyKeys(settings, rt);
+    else obs_data_set_string(settings, "rt_state", rt.EncodeState().c_str());
+    std::string json = obs_data_get_json(settings);
+    obs_data_release(settings);
+    return json;
+}
+
+size_t ParseAll(const std::vector<std::string> &jsons)
+{
+    size_t keys = 0;
+    for (const std::string &json : jsons) {
+        obs_data_t *settings = obs_data_create_from_json(json.c_str());
+        keys += obs_data_has_user_value(settings, "rt_state");
+        obs_data_release(settings);
+    }
+    return keys;
+}
+
+// Runs 'body' (one pass over 'items' items) until minNs passed, at least 3 samples.
+// Small passes are grouped so that the clock reads don't dominate a sample.
+Result Measure(const char *name, size_t items, uint64_t minNs, const std::function<void()> &body)
+{
+    using Clock = std::chrono::steady_clock;
+    const size_t passes = std::max<size_t>(1, 1000 / items);
+    std::vector<double> samples;
+    uint64_t total = 0;
+    body(); // Warm up caches
+    while (samples.size() < 3 || total < minNs) {
+        auto start = Clock::now();
+        for (size_t p = 0; p < passes; p++) body();
+        uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        total += ns;
+        samples.push_back((double)ns / (double)(items * passes));
+    }
+    std::sort(samples.begin(), samples.end());
+    return {name, items, samples.size(), samples[samples.size() / 2], samples.front()};
+}
+
+void RunSize(size_t n, uint64_t minNs, std::vector<Result> &results)
+{
+    const std::vector<RectTransform> transforms = MakeTransforms(n);
+    std::vector<RectTransform> work = transforms;
+
+    results.push_back(Measure("calculate_final_rect", n, minNs, [&]() {
+        float acc = 0.0f;
+        for (const RectTransform &rt : transforms) {
+            float x, y, w, h;
+            rt.CalculateFinalRect((float)canvasW, (float)canvasH, x, y, w, h);
+            acc += x + y + w + h;
+        }
+        sink = acc;
+    }));
+
+    results.push_back(Measure("get_pivot_world", n, minNs, [&]() {
+        float acc = 0.0f;
+        for (const RectTransform &rt : transforms) {
+            float x, y;
+            rt.GetPivotWorld((float)canvasW, (float)canvasH, x, y);
+            acc += x + y;
+        }
+        sink = acc;
+    }));
+
+    results.push_back(Measure("get_width_height", n, minNs, [&]() {
+        float acc = 0.0f;
+        for (const RectTransform &rt : transforms) acc += rt.GetWidth((float)canvasW) + rt.GetHeight((float)canvasH);
+        sink = acc;
+    }));
+
+    // Each modifier combination is its own branch of ApplyPreset
+    const struct {
+        const char *name;
+        bool shift, alt;
+    } presetCases[] = {
+        {"apply_anchor_preset_plain", false, false},
+        {"apply_anchor_preset_shift", true, false},
+        {"apply_anchor_preset_shift_alt", true, true},
+        {"apply_anchor_preset_alt", false, true},
+    };
+    for (const auto &c : presetCases) {
+        results.push_back(Measure(c.name, n, minNs, [&]() {
+            float acc = 0.0f;
+            for (size_t i = 0; i < n; i++) {
+                RectTransform rt = transforms[i];
+                rt.ApplyPreset(anchorPresets[(i / 3) % 4][(i / 5) % 4], c.shift, c.alt, (float)canvasW,
+                               (float)canvasH);
+                acc += rt.anchoredPosX + rt.sizeDeltaY;
+            }
+            sink = acc;
+        }));
+    }
+
+    // Scene-backed cases: one fake item per transform, live state applied
+    FakeObs::Reset();
+    FakeObs::Synthetic scene = FakeObs::BuildScene(n);
+    for (size_t i = 0; i < n; i++) transforms[i].ApplyToSceneItem(scene.items[i], canvasW, canvasH, false);
+
+    // LoadFromItem: stored anchors plus the inverse from the live OBS rect
+    for (size_t i = 0; i < n; i++) transforms[i].SaveToItem(scene.items[i]);
+    results.push_back(Measure("load_from_item_inverse", n, minNs, [&]() {
+        float acc = 0.0f;
+        for (obs_sceneitem_t *item : scene.items) {
+            RectTransform rt = RectTransform::LoadFromItem(item, canvasW, canvasH);
+            acc += rt.anchoredPosX + rt.sizeDeltaX;
+        }
+        sink = acc;
+    }));
+
+    // Save (always a real write: the state alternates) and load back from in-memory obs_data
+    bool flip = false;
+    results.push_back(Measure("save_load_roundtrip", n, minNs, [&]() {
+        flip = !flip;
+        float acc = 0.0f;
+        for (size_t i = 0; i < n; i++) {
+            work[i].anchoredPosX = transforms[i].anchoredPosX + (flip ? 1.0f : 0.0f);
+            work[i].SaveToItem(scene.items[i]);
+            RectTransform loaded;
+            RectTransform::LoadStored(scene.items[i], loaded);
+            acc += loaded.anchoredPosX;
+        }
+        sink = acc;
+    }));
+
+    // The same state through a JSON save of the settings, as on collection save/load
+    results.push_back(Measure("save_load_json_roundtrip", n, minNs, [&]() {
+        float acc = 0.0f;
+        for (const RectTransform &rt : transforms) {
+            obs_data_t *settings = obs_data_create();
+            obs_data_set_string(settings, "rt_state", rt.EncodeState().c_str());
+            obs_data_t *loaded = obs_data_create_from_json(obs_data_get_json(settings));
+            RectTransform back;
+            RectTransform::DecodeState(obs_data_get_string(loaded, "rt_state"), back);
+            acc += back.sizeDeltaX;
+            obs_data_release(loaded);
+            obs_data_release(settings);
+        }
+        sink = acc;
+    }));
+
+    // Packed "rt_state" vs. the ten rt_* doubles it replaced: reading the
+    // stored state, and parsing one item's settings JSON on collection load
+    std::vector<std::string> packedJson, legacyJson;
+    for (size_t i = 0; i < n; i++) {
+        packedJson.push_back(SettingsJson(transforms[i], false));
+        legacyJson.push_back(SettingsJson(transforms[i], true));
+    }
+    results.push_back(Measure("load_stored_packed", n, minNs, [&]() {
+        float acc = 0.0f;
+        for (obs_sceneitem_t *item : scene.items) {
+            RectTransform rt;
+            RectTransform::LoadStored(item, rt);
+            acc += rt.sizeDeltaX;
+        }
+        sink = acc;
+    }));
+    for (size_t i = 0; i < n; i++) {
+        obs_data_t *settings = obs_sceneitem_get_private_settings(scene.items[i]);
+        RectTransform::ClearStored(scene.items[i]);
+        SetLegacyKeys(settings, transforms[i]);
+        obs_data_release(settings);
+    }
+    results.push_back(Measure("load_stored_legacy", n, minNs, [&]() {
+        float acc = 0.0f;
+        for (obs_sceneitem_t *item : scene.items) {
+            // The old LoadStored: ten keys (LoadStored now migrates them on first read)
+            obs_data_t *settings = obs_sceneitem_get_private_settings(item);
+            if (obs_data_has_user_value(settings, legacyKeys[0])) {
+                for (const char *key : legacyKeys) acc += (float)obs_data_get_double(settings, key);
+            }
+            obs_data_release(settings);
+        }
+        sink = acc;
+    }));
+    results.push_back(Measure("parse_settings_packed", n, minNs, [&]() { sink = (float)ParseAll(packedJson); }));
+    results.push_back(Measure("parse_settings_legacy", n, minNs, [&]() { sink = (float)ParseAll(legacyJson); }));
+
+    FakeObs::Reset();
+}
+
+void WriteJson(FILE *out, const std::vector<Result> &results, uint64_t minNs)
+{
+    fprintf(out, "{\n  \"benchmark\": \"source-resizer\",\n");
+    fprintf(out, "  \"canvas\": [%u, %u],\n  \"min_time_ms\": %llu,\n", canvasW, canvasH,
+            (unsigned long long)(minNs / 1000000));
+    // Mean settings JSON per item over the 10k-item inputs (the libobs writer
+    // pretty-prints, so real files are larger; the ratio is what matters)
+    const std::vector<RectTransform> sample = MakeTransforms(10000);
+    double packedBytes = 0.0, legacyBytes = 0.0;
+    for (const RectTransform &rt : sample) {
+        packedBytes += (double)SettingsJson(rt, false).size();
+        legacyBytes += (double)SettingsJson(rt, true).size();
+    }
+    fprintf(out, "  \"state_json_bytes\": {\"packed\": %.1f, \"legacy\": %.1f},\n", packedBytes / sample.size(),
+            legacyBytes / sample.size());
+    fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        fprintf(out,
+                "    {\"case\": \"%s\", \"items\": %zu, \"samples\": %zu, \"median_ns_per_item\": %.2f, "
+                "\"best_ns_per_item\": %.2f}%s\n",
+                r.name.c_str(), r.items, r.samples, r.medianNs, r.bestNs, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    size_t maxItems = 100000;
+    uint64_t minNs = 200 * 1000000ull;
+    const char *outPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--max-items") && i + 1 < argc) {
+            maxItems = (size_t)strtoull(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--min-time-ms") && i + 1 < argc) {
+            minNs = strtoull(argv[++i], nullptr, 10) * 1000000ull;
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--max-items N] [--min-time-ms T] [--out FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Result> results;
+    for (size_t n = 1; n <= maxItems; n *= 10) RunSize(n, minNs, results);
+
+    FILE *out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "cannot write %s\n", outPath);
+        return 1;
+    }
+    WriteJson(out, results, minNs);
+    if (out != stdout) fclose(out);
+    return 0;
+}
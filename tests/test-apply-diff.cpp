@@ -0,0 +1,283 @@
+/*
+ * ApplyToSceneItem only calls the setters whose value changed, and the
+ * paths built on it (tick queue, write-behind saves, scene mirror) keep
+ * OBS calls and references in check. Runs against the fake libobs.
+ */
+
+#include <fake-obs.hpp>
+#include <string>
+#include "pending-saves.hpp"
+#include "rect-transform-cache.hpp"
+#include "rect-transform.hpp"
+#include "scene-graph-mirror.hpp"
+#include "test-support.hpp"
+#include "transform-queue.hpp"
+
+using FakeObs::GetCalls;
+
+static RectTransform TopLeft(float x, float y, float w, float h)
+{
+    RectTransform rt;
+    rt.anchorMinX = rt.anchorMaxX = 0.0f;
+    rt.anchorMinY = rt.anchorMaxY = 1.0f;
+    rt.pivotX = 0.0f;
+    rt.pivotY = 1.0f;
+    rt.anchoredPosX = x;
+    rt.anchoredPosY = -y;
+    rt.sizeDeltaX = w;
+    rt.sizeDeltaY = h;
+    return rt;
+}
+
+static void TestSettersFollowDiff()
+{
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(1);
+    obs_sceneitem_t *item = s.items[0];
+
+    // First apply: pos, bounds and bounds type/alignment differ from a fresh item
+    RectTransform rt = TopLeft(10.0f, 20.0f, 300.0f, 200.0f);
+    FakeObs::ResetCalls();
+    CHECK(rt.ApplyToSceneItem(item, 1920, 1080, false));
+    CHECK_EQ(GetCalls().setPos, 1u);
+    CHECK_EQ(GetCalls().setBounds, 1u);
+    CHECK_EQ(GetCalls().setBoundsType, 1u);
+    CHECK_EQ(GetCalls().setAlignment, 0u); // Already top-left
+    CHECK_EQ(GetCalls().deferBegin, 1u);
+    CHECK_EQ(GetCalls().Signals("item_transform"), 1u); // One signal for the deferred batch
+
+    // Same state again: nothing is touched, not even a deferred update
+    FakeObs::ResetCalls();
+    CHECK(!rt.ApplyToSceneItem(item, 1920, 1080, false));
+    CHECK_EQ(GetCalls().Setters(), 0u);
+    CHECK_EQ(GetCalls().deferBegin, 0u);
+    CHECK_EQ(GetCalls().Signals("item_transform"), 0u);
+
+    // Moving calls set_pos only
+    rt.anchoredPosX += 5.0f;
+    FakeObs::ResetCalls();
+    CHECK(rt.ApplyToSceneItem(item, 1920, 1080, false));
+    CHECK_EQ(GetCalls().setPos, 1u);
+    CHECK_EQ(GetCalls().Setters(), 1u);
+
+    // Resizing from the top-left pivot calls set_bounds only
+    rt.sizeDeltaX = 320.0f;
+    FakeObs::ResetCalls();
+    CHECK(rt.ApplyToSceneItem(item, 1920, 1080, false));
+    CHECK_EQ(GetCalls().setBounds, 1u);
+    CHECK_EQ(GetCalls().Setters(), 1u);
+
+    // Changes within applyEpsilon count as unchanged
+    rt.anchoredPosX += RectTransform::applyEpsilon * 0.5f;
+    FakeObs::ResetCalls();
+    CHECK(!rt.ApplyToSceneItem(item, 1920, 1080, false));
+    CHECK_EQ(GetCalls().Setters(), 0u);
+
+    // A pivot change moves the alignment and the position, not the size
+    rt.pivotX = 1.0f;
+    rt.anchoredPosX += 320.0f;
+    FakeObs::ResetCalls();
+    CHECK(rt.ApplyToSceneItem(item, 1920, 1080, false));
+    CHECK_EQ(GetCalls().setAlignment, 1u);
+    CHECK_EQ(GetCalls().setPos, 1u);
+    CHECK_EQ(GetCalls().Setters(), 2u);
+
+    // The round trip through the live item reproduces the state
+    RectTransform loaded = RectTransform::LoadFromItem(item, 1920, 1080);
+    CHECK(!PendingSaves::Find(item));
+    CHECK_NEAR(loaded.sizeDeltaX, 320.0f, 0.01);
+    CHECK_NEAR(loaded.sizeDeltaY, 200.0f, 0.01);
+}
+
+static void TestStatsCountSetters()
+{
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(8);
+
+    RectTransform::ApplyStats before = RectTransform::GetApplyStats();
+    FakeObs::ResetCalls();
+    for (int pass = 0; pass < 3; pass++) {
+        for (obs_sceneitem_t *item : s.items) TopLeft(0.0f, 0.0f, 50.0f, 50.0f).ApplyToSceneItem(item, 1920, 1080, false);
+    }
+    RectTransform::ApplyStats after = RectTransform::GetApplyStats();
+
+    CHECK_EQ(after.applies - before.applies, 24u);
+    CHECK_EQ(after.unchanged - before.unchanged, 16u); // Passes 2 and 3
+    CHECK_EQ(after.setters - before.setters, GetCalls().Setters());
+}
+
+static void TestQueueAppliesOnTick()
+{
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(4);
+    RectTransformCache cache;
+    {
+        TransformQueue queue(8);
+        cache.SetQueue(&queue);
+        CHECK_EQ(FakeObs::TickCallbacks(), 1u);
+
+        FakeObs::ResetCalls();
+        uint64_t ticket = 0;
+        for (obs_sceneitem_t *item : s.items) {
+            RectTransform rt = TopLeft(100.0f, 100.0f, 64.0f, 64.0f);
+            ticket = queue.Push(item, rt, 1920, 1080);
+            CHECK(ticket != 0);
+            cache.StoreExpected(item, rt, 1920, 1080, ticket);
+            CHECK_EQ(FakeObs::ItemRefs(item), 2); // The command holds a reference
+        }
+        CHECK_EQ(GetCalls().Setters(), 0u); // Nothing happens on the producer side
+        CHECK(!queue.Applied(ticket));
+
+        FakeObs::Tick();
+        CHECK(queue.Applied(ticket));
+        CHECK(queue.Empty());
+        CHECK_EQ(GetCalls().setPos, 4u);
+        for (obs_sceneitem_t *item : s.items) CHECK_EQ(FakeObs::ItemRefs(item), 1);
+
+        // Expected item_transform signals keep the cache entries
+        for (obs_sceneitem_t *item : s.items) cache.NoteTransform(item);
+        for (obs_sceneitem_t *item : s.items) cache.Load(item, 1920, 1080);
+        CHECK_EQ(cache.GetStats().invalidations, 0u);
+        CHECK_EQ(cache.GetStats().hits, 4u);
+
+        // A full queue rejects instead of blocking
+        for (int i = 0; i < 8; i++) CHECK(queue.Push(s.items[0], TopLeft(1.0f, 1.0f, 2.0f, 2.0f), 1920, 1080));
+        CHECK_EQ(queue.Push(s.items[0], TopLeft(1.0f, 1.0f, 2.0f, 2.0f), 1920, 1080), 0u);
+        CHECK_EQ(queue.GetStats().rejected, 1u);
+
+        cache.SetQueue(nullptr);
+    }
+    // Destruction unregisters the tick and applies what was left
+    CHECK_EQ(FakeObs::TickCallbacks(), 0u);
+    CHECK_EQ(FakeObs::ItemRefs(s.items[0]), 1);
+}
+
+static void TestPendingSavesWriteOnce()
+{
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(3);
+    obs_sceneitem_t *item = s.items[0];
+
+    // A drag: many applies, one pending state, no private-settings access
+    FakeObs::ResetCalls();
+    for (int i = 0; i < 50; i++) TopLeft((float)i, 0.0f, 100.0f, 100.0f).ApplyToSceneItem(item, 1920, 1080);
+    CHECK_EQ(PendingSaves::Size(), 1u);
+    CHECK_EQ(GetCalls().privateSettings, 1u); // The first Record checks what is stored
+    CHECK_EQ(FakeObs::ItemRefs(item), 2);
+
+    CHECK_EQ(PendingSaves::Flush(), 1u);
+    CHECK_EQ(PendingSaves::Size(), 0u);
+    CHECK_EQ(FakeObs::ItemRefs(item), 1);
+
+    RectTransform stored;
+    CHECK(RectTransform::LoadStored(item, stored));
+    CHECK_NEAR(stored.anchoredPosX, 49.0f, 0.0001);
+
+    // Applying the stored state again records nothing
+    CHECK(!stored.ApplyToSceneItem(item, 1920, 1080));
+    CHECK_EQ(PendingSaves::Size(), 0u);
+}
+
+static void TestNewerStateKept()
+{
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(1);
+    obs_sceneitem_t *item = s.items[0];
+
+    // A version 2 blob: byte 0 is the version, the second base64 digit holds its low bits
+    std::string newer = TopLeft(1.0f, 2.0f, 3.0f, 4.0f).EncodeState();
+    CHECK_EQ(newer[1], 'Q');
+    newer[1] = 'g';
+    obs_data_t *settings = obs_sceneitem_get_private_settings(item);
+    obs_data_set_string(settings, "rt_state", newer.c_str());
+
+    RectTransform stored;
+    bool isNewer = false;
+    CHECK(!RectTransform::LoadStored(item, stored, &isNewer));
+    CHECK(isNewer);
+    RectTransform anchors;
+    CHECK(!RectTransform::LoadAnchors(item, anchors));
+    CHECK_NEAR(anchors.pivotX, 0.0, 0.0001); // Inferred from the top-left alignment
+    CHECK_NEAR(anchors.pivotY, 1.0, 0.0001);
+
+    // Neither applies, direct saves nor undo clearing replace it
+    CHECK(TopLeft(10.0f, 20.0f, 300.0f, 200.0f).ApplyToSceneItem(item, 1920, 1080));
+    CHECK_EQ(PendingSaves::Size(), 0u);
+    CHECK(!TopLeft(10.0f, 20.0f, 300.0f, 200.0f).SaveToItem(item));
+    RectTransform::ClearStored(item);
+    PendingSaves::Flush();
+    CHECK(std::string(obs_data_get_string(settings, "rt_state")) == newer);
+    obs_data_release(settings);
+}
+
+static void TestMirrorWalksOnce()
+{
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(200, 4, 2);
+
+    SceneGraphMirror mirror;
+    FakeObs::ResetCalls();
+    mirror.Rebuild(s.scene);
+    CHECK_EQ(mirror.Size(), 204u);
+    CHECK_EQ(mirror.GroupCount(), 4u);
+    CHECK_EQ(GetCalls().enumItems, 5u); // Root plus one per group
+
+    // Selection lookups and visits do not enumerate the scene again
+    std::unordered_set<obs_sceneitem_t*> selection = {s.items[3], s.items[150]};
+    FakeObs::Select(s.items[3], true);
+    FakeObs::Select(s.items[150], true);
+    mirror.SyncSelection(selection);
+    size_t visited = 0;
+    mirror.ForEachSelected([&](obs_sceneitem_t *, uint32_t, uint32_t) { visited++; });
+    CHECK_EQ(visited, 2u);
+    CHECK_EQ(GetCalls().enumItems, 5u);
+
+    for (obs_sceneitem_t *item : s.items) CHECK_EQ(FakeObs::ItemRefs(item), 2);
+    mirror.Clear();
+    for (obs_sceneitem_t *item : s.items) CHECK_EQ(FakeObs::ItemRefs(item), 1);
+}
+
+static void TestPresetBranches()
+{
+    RectTransform rt = TopLeft(300.0f, 200.0f, 400.0f, 100.0f);
+    const AnchorPreset &stretchBoth = anchorPresets[3][3];
+
+    // Plain: new anchors, same world rect
+    float x0, y0, w0, h0, x1, y1, w1, h1;
+    rt.CalculateFinalRect(1920.0f, 1080.0f, x0, y0, w0, h0);
+    RectTransform plain = rt;
+    plain.ApplyPreset(stretchBoth, false, false, 1920.0f, 1080.0f);
+    plain.CalculateFinalRect(1920.0f, 1080.0f, x1, y1, w1, h1);
+    CHECK(plain.IsStretchX() && plain.IsStretchY());
+    CHECK_NEAR(x1, x0, 0.01);
+    CHECK_NEAR(y1, y0, 0.01);
+    CHECK_NEAR(w1, w0, 0.01);
+    CHECK_NEAR(h1, h0, 0.01);
+
+    // Shift+Alt: fills the parent
+    RectTransform reset = rt;
+    reset.ApplyPreset(stretchBoth, true, true, 1920.0f, 1080.0f);
+    CHECK_NEAR(reset.GetWidth(1920.0f), 1920.0, 0.01);
+    CHECK_NEAR(reset.GetHeight(1080.0f), 1080.0, 0.01);
+
+    // Alt: anchors kept, pivot moved to the preset's point
+    RectTransform moved = rt;
+    moved.ApplyPreset(anchorPresets[2][2], false, true, 1920.0f, 1080.0f);
+    float px, py;
+    moved.GetPivotWorld(1920.0f, 1080.0f, px, py);
+    CHECK_EQ(moved.anchorMinX, rt.anchorMinX);
+    CHECK_NEAR(px, 1920.0, 0.01);
+    CHECK_NEAR(py, 0.0, 0.01);
+}
+
+int main()
+{
+    TestPresetBranches();
+    TestSettersFollowDiff();
+    TestStatsCountSetters();
+    TestQueueAppliesOnTick();
+    TestPendingSavesWriteOnce();
+    TestNewerStateKept();
+    TestMirrorWalksOnce();
+    return TEST_RESULT();
+}
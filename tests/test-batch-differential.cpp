@@ -0,0 +1,151 @@
+/*
+ * RectTransformBatch kernels vs. the scalar path
+ *
+ * Runs once per kernel the CPU supports (RectTransformBatch::SetKernel):
+ * random anchors, pivots, offsets and sizes go through the batch passes
+ * and through RectTransform / RectLayout one item at a time, and every
+ * output has to agree within a small epsilon. Item counts that are no
+ * multiple of the vector width cover the narrower kernels and the tail.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <vector>
+#include "rect-transform-batch.hpp"
+#include "rect-transform.hpp"
+#include "test-support.hpp"
+
+struct Rng {
+    uint32_t state = 0x9e3779b9u;
+
+    uint32_t Next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    float Unit() { return (float)(Next() & 0xffffff) / (float)0xffffff; }
+    float Range(float lo, float hi) { return lo + (hi - lo) * Unit(); }
+
+    // Presets hit exact 0 / 0.5 / 1, the rest anywhere in between
+    float Anchor()
+    {
+        static const float exact[] = {0.0f, 0.5f, 1.0f};
+        return (Next() & 3) ? exact[Next() % 3] : Unit();
+    }
+};
+
+static RectTransform RandomTransform(Rng &rng)
+{
+    RectTransform rt;
+    rt.anchorMinX = rng.Anchor();
+    rt.anchorMaxX = (rng.Next() & 1) ? rt.anchorMinX : std::max(rt.anchorMinX, rng.Anchor());
+    rt.anchorMinY = rng.Anchor();
+    rt.anchorMaxY = (rng.Next() & 1) ? rt.anchorMinY : std::max(rt.anchorMinY, rng.Anchor());
+    rt.pivotX = rng.Anchor();
+    rt.pivotY = rng.Anchor();
+    rt.anchoredPosX = rng.Range(-4000.0f, 4000.0f);
+    rt.anchoredPosY = rng.Range(-4000.0f, 4000.0f);
+    rt.sizeDeltaX = rng.Range(-3000.0f, 3000.0f); // Negative sizes exercise the 1px clamp
+    rt.sizeDeltaY = rng.Range(-3000.0f, 3000.0f);
+    return rt;
+}
+
+// Relative to the magnitude of the value, absolute below 1px
+static double Epsilon(double reference)
+{
+    return 1e-5 * std::max(1.0, std::fabs(reference));
+}
+
+#define CHECK_CLOSE(actual, reference) CHECK_NEAR(actual, reference, Epsilon(reference))
+
+static void CheckSize(Rng &rng, size_t n)
+{
+    std::vector<RectTransform> transforms;
+    std::vector<uint32_t> parentW, parentH;
+    RectTransformBatch batch;
+    batch.Reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        transforms.push_back(RandomTransform(rng));
+        parentW.push_back(1 + rng.Next() % 7680);
+        parentH.push_back(1 + rng.Next() % 4320);
+        CHECK_EQ(batch.Add(transforms[i], parentW[i], parentH[i]), i);
+    }
+
+    // Forward: final rects and pivot world points
+    std::vector<float> x(n), y(n), w(n), h(n), px(n), py(n);
+    batch.CalculateFinalRects(x.data(), y.data(), w.data(), h.data(), px.data(), py.data());
+    for (size_t i = 0; i < n; i++) {
+        float rx, ry, rw, rh, rpx, rpy;
+        transforms[i].CalculateFinalRect((float)parentW[i], (float)parentH[i], rx, ry, rw, rh);
+        transforms[i].GetPivotWorld((float)parentW[i], (float)parentH[i], rpx, rpy);
+        CHECK_CLOSE(x[i], rx);
+        CHECK_CLOSE(y[i], ry);
+        CHECK_CLOSE(w[i], rw);
+        CHECK_CLOSE(h[i], rh);
+        CHECK_CLOSE(px[i], rpx);
+        CHECK_CLOSE(py[i], rpy);
+    }
+
+    // Without pivot outputs the rects are the same
+    std::vector<float> x2(n), y2(n), w2(n), h2(n);
+    batch.CalculateFinalRects(x2.data(), y2.data(), w2.data(), h2.data());
+    for (size_t i = 0; i < n; i++) {
+        CHECK_CLOSE(x2[i], x[i]);
+        CHECK_CLOSE(h2[i], h[i]);
+    }
+
+    // Inverse: offsets for random live rects vs RectLayout::Inverse
+    std::vector<float> livePX(n), livePY(n), liveW(n), liveH(n);
+    for (size_t i = 0; i < n; i++) {
+        livePX[i] = rng.Range(-2000.0f, 10000.0f);
+        livePY[i] = rng.Range(-2000.0f, 6000.0f);
+        liveW[i] = rng.Range(1.0f, 4000.0f);
+        liveH[i] = rng.Range(1.0f, 4000.0f);
+    }
+    batch.SolveOffsets(livePX.data(), livePY.data(), liveW.data(), liveH.data());
+    for (size_t i = 0; i < n; i++) {
+        RectTransform ref = transforms[i];
+        RectLayout::Inverse((float)parentW[i], ref.anchorMinX, ref.anchorMaxX, ref.pivotX, livePX[i], liveW[i],
+                            ref.anchoredPosX, ref.sizeDeltaX);
+        RectLayout::Inverse((float)parentH[i], ref.anchorMinY, ref.anchorMaxY, ref.pivotY, livePY[i], liveH[i],
+                            ref.anchoredPosY, ref.sizeDeltaY);
+
+        RectTransform solved = batch.Get(i);
+        CHECK_CLOSE(solved.anchoredPosX, ref.anchoredPosX);
+        CHECK_CLOSE(solved.anchoredPosY, ref.anchoredPosY);
+        CHECK_CLOSE(solved.sizeDeltaX, ref.sizeDeltaX);
+        CHECK_CLOSE(solved.sizeDeltaY, ref.sizeDeltaY);
+
+        // ... and laying the solved state out again lands on the live rect
+        float rpx, rpy;
+        solved.GetPivotWorld((float)parentW[i], (float)parentH[i], rpx, rpy);
+        CHECK_NEAR(rpx, livePX[i], 1e-3 * std::max(1.0f, std::fabs(livePX[i])));
+        CHECK_NEAR(rpy, livePY[i], 1e-3 * std::max(1.0f, std::fabs(livePY[i])));
+        CHECK_NEAR(solved.GetWidth((float)parentW[i]), liveW[i], 1e-3 * liveW[i]);
+    }
+}
+
+int main()
+{
+    using Kernel = RectTransformBatch::Kernel;
+    printf("best batch kernel: %s\n", RectTransformBatch::KernelName(RectTransformBatch::BestKernel()));
+
+    for (Kernel kernel : {Kernel::Scalar, Kernel::SSE2, Kernel::AVX2}) {
+        if (!RectTransformBatch::SetKernel(kernel)) {
+            printf("%s: not supported here, skipped\n", RectTransformBatch::KernelName(kernel));
+            continue;
+        }
+        printf("%s\n", RectTransformBatch::KernelName(kernel));
+
+        Rng rng;
+        for (size_t n = 0; n <= 19; n++) CheckSize(rng, n); // Every tail length of both widths
+        CheckSize(rng, 1003);
+        CheckSize(rng, 65536 + 5);
+    }
+    return TEST_RESULT();
+}
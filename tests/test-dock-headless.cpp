@@ -0,0 +1,238 @@
+/*
+ * The dock on the offscreen Qt platform against the fake libobs: spin box
+ * edits reach the scene through the tick queue, and only the setters of
+ * the fields that changed are called. Bulk operations undo exactly their
+ * own items, whatever the selection is by then. Groups are laid out even
+ * while the dock was never shown.
+ */
+
+#include <QApplication>
+#include <QCheckBox>
+#include <fake-obs.hpp>
+#include "bulk-scheduler.hpp"
+#include "dock-support.hpp"
+#include "group-solver.hpp"
+#include "pending-saves.hpp"
+#include "rect-transform.hpp"
+#include "source-resizer-dock.hpp"
+#include "test-support.hpp"
+
+using DockSupport::Pump;
+using FakeObs::GetCalls;
+
+// Top-left anchored at the origin, 'w' x 100
+static RectTransform TopLeftRect(float w)
+{
+    RectTransform rt;
+    rt.anchorMinX = rt.anchorMaxX = 0.0f;
+    rt.anchorMinY = rt.anchorMaxY = 1.0f;
+    rt.pivotX = 0.0f;
+    rt.pivotY = 1.0f;
+    rt.sizeDeltaX = w;
+    rt.sizeDeltaY = 100.0f;
+    return rt;
+}
+
+// Pump, run one graphics tick for the queued transforms, pump the refresh it caused
+static void Frame()
+{
+    Pump();
+    FakeObs::Tick();
+    Pump();
+}
+
+static float BoundsX(obs_sceneitem_t *item)
+{
+    vec2 bounds;
+    obs_sceneitem_get_bounds(item, &bounds);
+    return bounds.x;
+}
+
+// The selection changes while the operation runs: the undo action still
+// covers the targets and nothing else
+static void TestBulkUndoFollowsTargets()
+{
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(3);
+    obs_sceneitem_t *target = s.items[0];
+    obs_sceneitem_t *other = s.items[1];
+    FakeObs::Select(target, true);
+    float targetBefore = BoundsX(target);
+
+    BulkScheduler bulk(nullptr);
+    bulk.Start("Resize", false, s.scene, {{target, 1920, 1080}}, [&](obs_sceneitem_t *item, uint32_t w, uint32_t h) {
+        TopLeftRect(400.0f).ApplyToSceneItem(item, w, h);
+        FakeObs::Select(target, false);
+        FakeObs::Select(other, true);
+    });
+    CHECK(!bulk.Running());
+    CHECK_NEAR(BoundsX(target), 400.0, 0.001);
+
+    // Somebody else resizes the now selected item; undo must not touch it
+    vec2 otherBounds = {123.0f, 45.0f};
+    obs_sceneitem_set_bounds(other, &otherBounds);
+
+    CHECK_EQ(FakeObs::UndoCount(), 1u);
+    CHECK(FakeObs::Undo());
+    CHECK_NEAR(BoundsX(target), targetBefore, 0.001);
+    CHECK_NEAR(BoundsX(other), 123.0, 0.001);
+    CHECK(FakeObs::Redo());
+    CHECK_NEAR(BoundsX(target), 400.0, 0.001);
+
+    PendingSaves::Flush();
+}
+
+static void TestHiddenDockLaysOutGroups()
+{
+    FakeObs::Reset();
+    obs_scene_t *scene = FakeObs::CreateScene("scene");
+    obs_sceneitem_t *group = FakeObs::AddGroup(scene, "group", 300, 100);
+    obs_scene_t *contents = obs_sceneitem_group_get_scene(group);
+    obs_source_t *groupSource = obs_sceneitem_get_source(group);
+
+    // Full-width stretch child next to a fixed one that sets the group's width
+    obs_sceneitem_t *fixed = FakeObs::AddItem(contents, FakeObs::CreateSource("fixed", 300, 100));
+    obs_sceneitem_t *stretch = FakeObs::AddItem(contents, FakeObs::CreateSource("stretch", 300, 50));
+    RectTransform rt = TopLeftRect(0.0f);
+    rt.anchorMaxX = 1.0f;
+    rt.sizeDeltaY = 50.0f;
+    rt.ApplyToSceneItem(stretch, 300, 100);
+    PendingSaves::Flush();
+    FakeObs::SetCurrentScene(scene);
+
+    {
+        SourceResizerDock dock;
+        Pump();
+
+        // Never shown: no tick work, but the group follows its fixed child
+        vec2 bounds = {400.0f, 100.0f};
+        obs_sceneitem_set_bounds_type(fixed, OBS_BOUNDS_STRETCH);
+        obs_sceneitem_set_bounds(fixed, &bounds);
+        CHECK_EQ(obs_source_get_width(groupSource), 400u);
+        Pump(200);
+        CHECK_EQ(FakeObs::TickCallbacks(), 0u);
+        GroupSolver::Child box;
+        GroupSolver::ReadBox(stretch, box);
+        CHECK_NEAR(box.right - box.left, 400.0, 0.01);
+
+        // Same after it was shown and hidden again
+        dock.show();
+        Pump();
+        dock.hide();
+        Pump();
+        bounds.x = 500.0f;
+        obs_sceneitem_set_bounds(fixed, &bounds);
+        Pump(200);
+        GroupSolver::ReadBox(stretch, box);
+        CHECK_NEAR(box.right - box.left, 500.0, 0.01);
+        FakeObs::SendFrontendEvent(OBS_FRONTEND_EVENT_EXIT);
+    }
+    PendingSaves::Flush();
+}
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(3);
+    FakeObs::SetCurrentScene(s.scene);
+    obs_sceneitem_t *item = s.items[0];
+
+    {
+        SourceResizerDock dock;
+        CHECK_EQ(FakeObs::TickCallbacks(), 0u); // Nothing runs before the first show
+
+        FakeObs::ResetCalls();
+        dock.show();
+        Pump();
+        CHECK_EQ(FakeObs::TickCallbacks(), 1u);
+        CHECK_EQ(GetCalls().Setters(), 0u); // Showing never writes to the scene
+
+        DockSupport::Spins spins = DockSupport::FindSpins(dock);
+        CHECK(spins.x && spins.y && spins.w && spins.h);
+        if (!spins.h) return TEST_RESULT();
+
+        FakeObs::Select(item, true);
+        Pump();
+        CHECK_EQ(spins.w->value(), 100);
+        CHECK_EQ(spins.h->value(), 100);
+        CHECK_EQ(GetCalls().Setters(), 0u);
+
+        // First resize: bounds and bounds type; the top-left pivot keeps pos and alignment
+        FakeObs::ResetCalls();
+        spins.w->setValue(250);
+        CHECK_EQ(GetCalls().Setters(), 0u); // Queued for the graphics thread
+        Frame();
+        CHECK_EQ(GetCalls().setBounds, 1u);
+        CHECK_EQ(GetCalls().setBoundsType, 1u);
+        CHECK_EQ(GetCalls().setPos, 0u);
+        CHECK_EQ(GetCalls().setAlignment, 0u);
+        CHECK_EQ(GetCalls().Setters(), 2u);
+
+        // Second resize: bounds only
+        FakeObs::ResetCalls();
+        spins.h->setValue(150);
+        Frame();
+        CHECK_EQ(GetCalls().setBounds, 1u);
+        CHECK_EQ(GetCalls().Setters(), 1u);
+        vec2 bounds;
+        obs_sceneitem_get_bounds(item, &bounds);
+        CHECK_NEAR(bounds.x, 250.0, 0.001);
+        CHECK_NEAR(bounds.y, 150.0, 0.001);
+
+        // The refreshes caused by our own transforms write nothing back
+        FakeObs::ResetCalls();
+        Frame();
+        CHECK_EQ(GetCalls().Setters(), 0u);
+        CHECK_EQ(spins.w->value(), 250);
+
+        // Moving: pos only
+        FakeObs::ResetCalls();
+        spins.x->setValue(spins.x->value() + 40);
+        Frame();
+        CHECK_EQ(GetCalls().setPos, 1u);
+        CHECK_EQ(GetCalls().Setters(), 1u);
+
+        // Visibility: set_visible only
+        QCheckBox *vis = dock.findChild<QCheckBox*>();
+        CHECK(vis);
+        FakeObs::ResetCalls();
+        if (vis) vis->click();
+        Frame();
+        CHECK_EQ(GetCalls().setVisible, 1u);
+        CHECK_EQ(GetCalls().Setters(), 1u);
+        CHECK(!obs_sceneitem_visible(item));
+
+        // State is written to the private settings when the collection is saved
+        RectTransform stored;
+        CHECK(!RectTransform::LoadStored(item, stored));
+        CHECK(PendingSaves::Size() == 1);
+        FakeObs::Save();
+        CHECK(RectTransform::LoadStored(item, stored));
+        CHECK_NEAR(stored.sizeDeltaX, 250.0, 0.001);
+
+        // Each edit is one undo step; undoing the move leaves the size alone
+        CHECK_EQ(FakeObs::UndoCount(), 3u);
+        CHECK(FakeObs::Undo());
+        Frame();
+        obs_sceneitem_get_bounds(item, &bounds);
+        CHECK_NEAR(bounds.x, 250.0, 0.001);
+        CHECK_NEAR(bounds.y, 150.0, 0.001);
+
+        // Hiding drops the tick work; the scene stays tracked (the mirror
+        // holds a reference) until the collection goes away
+        dock.hide();
+        Pump();
+        CHECK_EQ(FakeObs::TickCallbacks(), 0u);
+        CHECK_EQ(FakeObs::ItemRefs(item), 2);
+        FakeObs::SendFrontendEvent(OBS_FRONTEND_EVENT_EXIT);
+        CHECK_EQ(FakeObs::ItemRefs(item), 1);
+    }
+
+    PendingSaves::Flush();
+    TestBulkUndoFollowsTargets();
+    TestHiddenDockLaysOutGroups();
+    FakeObs::Reset();
+    return TEST_RESULT();
+}
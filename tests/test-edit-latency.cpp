@@ -0,0 +1,227 @@
+/*
+ * Synthetic input-to-scene latency harness
+ *
+ *   test-edit-latency [--edits N]
+ *
+ * Drives the dock on the offscreen platform with 1, 50 and 1000 selected
+ * items: a frame timer ticks the fake libobs at 60 fps (on the UI thread,
+ * in place of the graphics thread), and each synthetic edit is timed from
+ * the input until the last selected item's setter ran. Edits are spaced
+ * irregularly so they hit every phase of the frame.
+ *
+ * Scenarios: X and width spin box edits, anchor popup preset clicks, and
+ * X edits right after the selection switched to another set of items.
+ * A preset that only changes anchors calls no setter; it has landed once
+ * the dock's own EditLatency closed the edit.
+ *
+ * Prints p50/p99/max and the dock's redundant selection refreshes per
+ * edit, per scenario and selection size, as JSON. Fails if an edit never
+ * lands or a small selection takes more than a few frames typically.
+ */
+
+#include <QApplication>
+#include <QTimer>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fake-obs.hpp>
+#include <util/platform.h>
+#include "anchor-button.hpp"
+#include "dock-support.hpp"
+#include "edit-latency.hpp"
+#include "pending-saves.hpp"
+#include "source-resizer-dock.hpp"
+#include "test-support.hpp"
+
+namespace {
+
+const uint64_t timeoutNs = 2000000000ull;
+
+// Loose enough for a loaded CI machine, tight enough to catch a lost frame timer
+const double smallSelectionP50Ms = 100.0;
+
+enum class Scenario { MoveX, Width, AnchorPreset, Reselect };
+
+const struct {
+    Scenario scenario;
+    const char *name;
+} scenarios[] = {
+    {Scenario::MoveX, "x"},
+    {Scenario::Width, "width"},
+    {Scenario::AnchorPreset, "anchor_preset"},
+    {Scenario::Reselect, "reselect"},
+};
+
+struct Run {
+    size_t selected;
+    std::vector<double> latenciesMs;
+    size_t timeouts = 0;
+    double redundantRefreshesPerEdit = 0.0; // As counted by the dock
+};
+
+double Percentile(std::vector<double> sorted, double p)
+{
+    if (sorted.empty()) return 0.0;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * (double)sorted.size()))];
+}
+
+// Newest setter time over the selection, or 0 while any item has not seen one since 'since'
+uint64_t Landed(const std::vector<obs_sceneitem_t*> &items, uint64_t since)
+{
+    uint64_t last = 0;
+    for (obs_sceneitem_t *item : items) {
+        uint64_t ns = FakeObs::LastSetterNs(item);
+        if (ns < since) return 0;
+        last = std::max(last, ns);
+    }
+    return last;
+}
+
+void Select(const std::vector<obs_sceneitem_t*> &items, bool select)
+{
+    for (obs_sceneitem_t *item : items) FakeObs::Select(item, select);
+}
+
+// Popup buttons in grid order (the first click on the main button creates the popup)
+std::vector<AnchorButton*> PresetButtons(SourceResizerDock &dock)
+{
+    AnchorButton *main = dock.findChild<AnchorButton*>();
+    if (main) main->click();
+
+    std::vector<AnchorButton*> presets;
+    for (AnchorButton *button : dock.findChildren<AnchorButton*>()) {
+        if (button->window() != &dock) presets.push_back(button);
+    }
+    return presets;
+}
+
+Run Measure(Scenario scenario, size_t selected, int edits)
+{
+    Run run;
+    run.selected = selected;
+
+    // Reselect switches between two disjoint sets of items
+    FakeObs::Reset();
+    FakeObs::Synthetic s = FakeObs::BuildScene(2 * selected + 10);
+    FakeObs::SetCurrentScene(s.scene);
+    std::vector<obs_sceneitem_t*> items(s.items.begin(), s.items.begin() + selected);
+    std::vector<obs_sceneitem_t*> others(s.items.begin() + selected, s.items.begin() + 2 * selected);
+
+    {
+        SourceResizerDock dock;
+        dock.show();
+
+        QTimer frames;
+        frames.setTimerType(Qt::PreciseTimer);
+        frames.setInterval(1000 / 60);
+        QObject::connect(&frames, &QTimer::timeout, []() { FakeObs::Tick(); });
+        frames.start();
+
+        Select(items, true);
+        DockSupport::Pump(100);
+
+        DockSupport::Spins spins = DockSupport::FindSpins(dock);
+        std::vector<AnchorButton*> presets;
+        if (scenario == Scenario::AnchorPreset) presets = PresetButtons(dock);
+        CHECK(spins.x && spins.w);
+        CHECK(scenario != Scenario::AnchorPreset || presets.size() == 16);
+        if (!spins.x || !spins.w || (scenario == Scenario::AnchorPreset && presets.empty())) return run;
+        const EditLatency &latency = dock.Latency();
+        EditLatency::Summary before = latency.Summarize();
+
+        for (int k = 0; k < edits; k++) {
+            // Like clicking another source: the dock shows it before the edit starts
+            if (scenario == Scenario::Reselect) {
+                Select(items, false);
+                std::swap(items, others);
+                Select(items, true);
+                DockSupport::Pump(20);
+            }
+
+            uint64_t inputNs = os_gettime_ns();
+            uint64_t editsBefore = latency.Summarize().edits;
+            switch (scenario) {
+                case Scenario::MoveX:
+                case Scenario::Reselect:
+                    // Far outside the synthetic positions, so every item really moves
+                    spins.x->setValue(-3000 - k);
+                    break;
+                case Scenario::Width: spins.w->setValue(k % 2 ? 300 + k : 1200 - k); break;
+                case Scenario::AnchorPreset: presets[(size_t)k % presets.size()]->click(); break;
+            }
+
+            uint64_t landedNs = 0;
+            while (os_gettime_ns() - inputNs < timeoutNs) {
+                if (scenario != Scenario::AnchorPreset) {
+                    landedNs = Landed(items, inputNs);
+                } else if (latency.Summarize().edits > editsBefore) {
+                    landedNs = os_gettime_ns();
+                }
+                if (landedNs) break;
+                QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+            }
+            if (landedNs) run.latenciesMs.push_back((double)(landedNs - inputNs) / 1e6);
+            else run.timeouts++;
+
+            // Vary the phase of the next input against the frame timer
+            DockSupport::Pump(3 + (k * 7) % 17);
+        }
+
+        EditLatency::Summary after = latency.Summarize();
+        if (after.edits > before.edits) {
+            run.redundantRefreshesPerEdit = (double)(after.redundantRefreshes - before.redundantRefreshes) /
+                                            (double)(after.edits - before.edits);
+        }
+
+        frames.stop();
+        dock.hide();
+    }
+
+    PendingSaves::Flush();
+    FakeObs::Reset();
+    return run;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+
+    int edits = 0; // Default: per selection size
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--edits") && i + 1 < argc) edits = atoi(argv[++i]);
+    }
+
+    const struct {
+        size_t selected;
+        int edits;
+    } sizes[] = {{1, 60}, {50, 60}, {1000, 15}};
+
+    const size_t nSizes = sizeof(sizes) / sizeof(sizes[0]);
+    const size_t nScenarios = sizeof(scenarios) / sizeof(scenarios[0]);
+
+    printf("{\n  \"harness\": \"edit-latency\",\n  \"fps\": 60,\n  \"results\": [\n");
+    for (size_t j = 0; j < nScenarios; j++) {
+        for (size_t i = 0; i < nSizes; i++) {
+            Run run = Measure(scenarios[j].scenario, sizes[i].selected, edits > 0 ? edits : sizes[i].edits);
+            double p50 = Percentile(run.latenciesMs, 0.50);
+            double p99 = Percentile(run.latenciesMs, 0.99);
+            double max = Percentile(run.latenciesMs, 1.0);
+            printf("    {\"scenario\": \"%s\", \"selected\": %zu, \"edits\": %zu, \"timeouts\": %zu, "
+                   "\"p50_ms\": %.2f, \"p99_ms\": %.2f, \"max_ms\": %.2f, \"redundant_refreshes_per_edit\": %.2f}%s\n",
+                   scenarios[j].name, run.selected, run.latenciesMs.size() + run.timeouts, run.timeouts, p50, p99,
+                   max, run.redundantRefreshesPerEdit, j + 1 < nScenarios || i + 1 < nSizes ? "," : "");
+            fflush(stdout);
+
+            CHECK_EQ(run.timeouts, 0u);
+            CHECK(!run.latenciesMs.empty());
+            if (run.selected <= 50) CHECK(p50 <= smallSelectionP50Ms);
+        }
+    }
+    printf("  ]\n}\n");
+    return TEST_RESULT();
+}
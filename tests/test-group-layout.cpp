@@ -0,0 +1,162 @@
+/*
+ * GroupLayout against the fake libobs, which fits groups to their children
+ * like libobs does: a group whose anchored child needs more than one solver
+ * pass is applied once and settles at the solved size in the same frame,
+ * without a follow-up layout; a group that does not settle is left alone.
+ */
+
+#include <QApplication>
+#include <fake-obs.hpp>
+#include "dock-support.hpp"
+#include "group-layout.hpp"
+#include "pending-saves.hpp"
+#include "rect-transform.hpp"
+#include "selection-tracker.hpp"
+#include "test-support.hpp"
+
+using DockSupport::Pump;
+
+static void Box(obs_sceneitem_t *item, float &left, float &right)
+{
+    GroupSolver::Child child;
+    GroupSolver::ReadBox(item, child);
+    left = child.left;
+    right = child.right;
+}
+
+static obs_sceneitem_t *AddBoxed(obs_scene_t *group, const char *name, float x, float w, float h)
+{
+    obs_sceneitem_t *item = FakeObs::AddItem(group, FakeObs::CreateSource(name, (uint32_t)w, (uint32_t)h));
+    vec2 pos = {x, 0.0f}, bounds = {w, h};
+    obs_sceneitem_set_bounds_type(item, OBS_BOUNDS_STRETCH);
+    obs_sceneitem_set_bounds(item, &bounds);
+    obs_sceneitem_set_pos(item, &pos);
+    return item;
+}
+
+// Right-anchored at the top, 'w' x 50, its right edge 'inset' px from the group's
+static void AnchorRight(obs_sceneitem_t *item, float inset, float w, uint32_t groupW, uint32_t groupH)
+{
+    RectTransform rt;
+    rt.anchorMinX = rt.anchorMaxX = 1.0f;
+    rt.anchorMinY = rt.anchorMaxY = 1.0f;
+    rt.pivotX = 1.0f;
+    rt.pivotY = 1.0f;
+    rt.anchoredPosX = -inset;
+    rt.sizeDeltaX = w;
+    rt.sizeDeltaY = 50.0f;
+    rt.ApplyToSceneItem(item, groupW, groupH);
+    PendingSaves::Flush();
+}
+
+static void TestSettlesInOneFrame()
+{
+    FakeObs::Reset();
+    obs_scene_t *scene = FakeObs::CreateScene("scene");
+    obs_sceneitem_t *group = FakeObs::AddGroup(scene, "group", 350, 100);
+    obs_scene_t *contents = obs_sceneitem_group_get_scene(group);
+
+    // A fixed child defines the right edge; the anchored one hangs off it.
+    // The fake refits the group on every change, so the left one goes first.
+    obs_sceneitem_t *anchored = AddBoxed(contents, "anchored", 0.0f, 300.0f, 50.0f);
+    obs_sceneitem_t *fixed = AddBoxed(contents, "fixed", 250.0f, 100.0f, 100.0f);
+    AnchorRight(anchored, 50.0f, 300.0f, 350, 100);
+    obs_source_t *groupSource = obs_sceneitem_get_source(group);
+    CHECK_EQ(obs_source_get_width(groupSource), 350u);
+
+    SelectionTracker tracker;
+    GroupLayout layout(&tracker);
+    QObject::connect(&tracker, &SelectionTracker::GroupResized, &layout, &GroupLayout::MarkDirty);
+    int resizes = 0;
+    QObject::connect(&tracker, &SelectionTracker::GroupResized, [&]() { resizes++; });
+    tracker.Attach(scene);
+    Pump();
+
+    // The fixed child grows by 100 px. Laid out for 450 px the anchored child
+    // moves right and the box origin with it: the group settles at 350 px
+    // again after the second solver pass.
+    vec2 bounds = {200.0f, 100.0f};
+    obs_sceneitem_set_bounds(fixed, &bounds);
+    CHECK_EQ(obs_source_get_width(groupSource), 450u);
+    Pump(200);
+
+    const GroupLayout::Stats &stats = layout.GetStats();
+    CHECK_EQ(stats.nodesVisited, 1u);
+    CHECK_EQ(stats.itemsApplied, 1u);
+    CHECK(stats.solverPasses >= 2);
+    CHECK_EQ(stats.unconverged, 0u);
+
+    // One apply moved the box corner: OBS' shift lands the group at the solved size
+    CHECK_EQ(obs_source_get_width(groupSource), 350u);
+    CHECK_EQ(obs_source_get_height(groupSource), 100u);
+    float left, right;
+    Box(anchored, left, right);
+    CHECK_NEAR(left, 0.0, 0.01);
+    CHECK_NEAR(right, 300.0, 0.01);
+    Box(fixed, left, right);
+    CHECK_NEAR(left, 150.0, 0.01);
+    CHECK_NEAR(right, 350.0, 0.01);
+
+    // The user's resize and the one the apply caused (to the solved size);
+    // nothing follows
+    CHECK_EQ(resizes, 2);
+    Pump(200);
+    CHECK_EQ(resizes, 2);
+    CHECK_EQ(stats.nodesVisited, 1u);
+    CHECK_EQ(stats.itemsApplied, 1u);
+
+    // The stored state is the one for the settled group
+    RectTransform stored;
+    PendingSaves::Flush();
+    CHECK(RectTransform::LoadStored(anchored, stored));
+    CHECK_NEAR(stored.anchoredPosX, -50.0, 0.01);
+    tracker.Detach();
+}
+
+static void TestUnconvergedLeftAlone()
+{
+    FakeObs::Reset();
+    obs_scene_t *scene = FakeObs::CreateScene("scene");
+    obs_sceneitem_t *group = FakeObs::AddGroup(scene, "group", 300, 100);
+    obs_scene_t *contents = obs_sceneitem_group_get_scene(group);
+
+    // Sticks out 50 px to the right of the group: every pass grows it by 50
+    obs_sceneitem_t *anchored = AddBoxed(contents, "anchored", 0.0f, 300.0f, 50.0f);
+    obs_sceneitem_t *fixed = AddBoxed(contents, "fixed", 0.0f, 100.0f, 100.0f);
+    AnchorRight(anchored, -50.0f, 300.0f, 300, 100);
+    obs_source_t *groupSource = obs_sceneitem_get_source(group);
+    CHECK_EQ(obs_source_get_width(groupSource), 350u);
+
+    SelectionTracker tracker;
+    GroupLayout layout(&tracker);
+    QObject::connect(&tracker, &SelectionTracker::GroupResized, &layout, &GroupLayout::MarkDirty);
+    tracker.Attach(scene);
+    Pump();
+
+    // Moving the fixed child left resizes the group
+    vec2 pos = {-20.0f, 0.0f};
+    obs_sceneitem_set_pos(fixed, &pos);
+    CHECK_EQ(obs_source_get_width(groupSource), 370u);
+    Pump(200);
+    uint32_t w = obs_source_get_width(groupSource);
+
+    const GroupLayout::Stats &stats = layout.GetStats();
+    CHECK_EQ(stats.unconverged, 1u);
+    CHECK_EQ(stats.itemsApplied, 0u);
+    Pump(200);
+    CHECK_EQ(obs_source_get_width(groupSource), w);
+    CHECK_EQ(stats.unconverged, 1u);
+    tracker.Detach();
+}
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+
+    TestSettlesInOneFrame();
+    TestUnconvergedLeftAlone();
+
+    PendingSaves::Flush();
+    FakeObs::Reset();
+    return TEST_RESULT();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+/**
+ * Minimal assertions for the headless tests
+ *
+ * A failed CHECK prints the expression and keeps going; each test's main()
+ * returns TEST_RESULT() so ctest sees any failure.
+ */
+namespace TestSupport {
+
+inline int &Failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline void Fail(const char *file, int line, const char *expr)
+{
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    Failures()++;
+}
+
+inline bool Near(double a, double b, double epsilon)
+{
+    return std::fabs(a - b) <= epsilon;
+}
+
+} // namespace TestSupport
+
+#define CHECK(expr)                                                        \
+    do {                                                                   \
+        if (!(expr)) TestSupport::Fail(__FILE__, __LINE__, #expr);         \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                                  \
+    do {                                                                                                \
+        auto checkA_ = (a);                                                                             \
+        auto checkB_ = (b);                                                                             \
+        if (!(checkA_ == checkB_)) {                                                                    \
+            TestSupport::Fail(__FILE__, __LINE__, #a " == " #b);                                        \
+            fprintf(stderr, "    %lld vs %lld\n", (long long)checkA_, (long long)checkB_);              \
+        }                                                                                               \
+    } while (0)
+
+#define CHECK_NEAR(a, b, epsilon)                                                                       \
+    do {                                                                                                \
+        double checkA_ = (a);                                                                           \
+        double checkB_ = (b);                                                                           \
+        if (!TestSupport::Near(checkA_, checkB_, (epsilon))) {                                          \
+            TestSupport::Fail(__FILE__, __LINE__, #a " ~= " #b);                                        \
+            fprintf(stderr, "    %.9g vs %.9g\n", checkA_, checkB_);                                    \
+        }                                                                                               \
+    } while (0)
+
+#define TEST_RESULT()                                                                                   \
+    (TestSupport::Failures() ? (fprintf(stderr, "%d check(s) failed\n", TestSupport::Failures()), 1)   \
+                             : 0)
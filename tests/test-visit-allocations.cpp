@@ -0,0 +1,130 @@
+/*
+ * Scene visitors allocate nothing: SceneVisit::EnumItems / Call and the
+ * SceneGraphMirror visitors are walked over a synthetic tree with a
+ * counting global operator new. Wrapping the same visitor in a
+ * std::function is the positive control for the counter.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <unordered_set>
+#include <fake-obs.hpp>
+#include "scene-graph-mirror.hpp"
+#include "scene-visit.hpp"
+#include "test-support.hpp"
+
+static std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+// Allocations made while running 'body'
+template<typename Body> static size_t Count(Body &&body)
+{
+    size_t before = allocations.load(std::memory_order_relaxed);
+    body();
+    return allocations.load(std::memory_order_relaxed) - before;
+}
+
+int main()
+{
+    FakeObs::Synthetic s = FakeObs::BuildScene(5000, 16, 3);
+    SceneGraphMirror mirror;
+    mirror.Rebuild(s.scene);
+
+    std::unordered_set<obs_sceneitem_t*> selection;
+    for (size_t i = 0; i < s.items.size(); i += 7) selection.insert(s.items[i]);
+    mirror.SyncSelection(selection);
+
+    // Captures well beyond std::function's small-buffer size
+    size_t visited = 0;
+    uint64_t sumW = 0, sumH = 0;
+    int64_t idSum = 0;
+    auto visitor = [&visited, &sumW, &sumH, &idSum](obs_sceneitem_t *item, uint32_t w, uint32_t h) {
+        visited++;
+        sumW += w;
+        sumH += h;
+        idSum += obs_sceneitem_get_id(item);
+    };
+
+    CHECK_EQ(Count([&]() { mirror.ForEach(SceneGraphMirror::Filter::All, visitor); }), 0u);
+    CHECK_EQ(visited, mirror.Size());
+
+    visited = 0;
+    CHECK_EQ(Count([&]() { mirror.ForEach(SceneGraphMirror::Filter::Selected, visitor); }), 0u);
+    CHECK_EQ(visited, selection.size());
+
+    visited = 0;
+    CHECK_EQ(Count([&]() { mirror.ForEachSelected(visitor); }), 0u);
+    CHECK_EQ(visited, selection.size());
+
+    visited = 0;
+    CHECK_EQ(Count([&]() {
+                 mirror.ForEachChild(nullptr, visitor);
+                 for (obs_sceneitem_t *group : s.groups) mirror.ForEachChild(group, visitor);
+             }),
+             0u);
+    CHECK_EQ(visited, mirror.Size());
+
+    visited = 0;
+    CHECK_EQ(Count([&]() { mirror.ForEachGroup(visitor); }), 0u);
+    CHECK_EQ(visited, s.groups.size());
+
+    // Early stop through a bool visitor
+    size_t seen = 0;
+    CHECK_EQ(Count([&]() {
+                 CHECK(!mirror.ForEach(SceneGraphMirror::Filter::All, [&](obs_sceneitem_t *, uint32_t, uint32_t) {
+                     return ++seen < 10;
+                 }));
+             }),
+             0u);
+    CHECK_EQ(seen, 10u);
+
+    // Raw scene enumeration, recursing into groups
+    size_t enumerated = 0;
+    auto walk = [&](auto &self, obs_scene_t *scene) -> void {
+        SceneVisit::EnumItems(scene, [&](obs_scene_t *, obs_sceneitem_t *item) {
+            enumerated++;
+            sumW += obs_sceneitem_get_id(item);
+            if (obs_sceneitem_is_group(item)) self(self, obs_sceneitem_group_get_scene(item));
+        });
+    };
+    CHECK_EQ(Count([&]() { walk(walk, s.scene); }), 0u);
+    CHECK_EQ(enumerated, mirror.Size());
+
+    size_t calls = 0;
+    CHECK_EQ(Count([&]() {
+                 for (obs_sceneitem_t *item : s.items) {
+                     if (SceneVisit::Call(visitor, item, 1u, 1u)) calls++;
+                 }
+             }),
+             0u);
+    CHECK_EQ(calls, s.items.size());
+
+    // Positive control: the std::function the templates replaced does allocate
+    size_t control = Count([&]() {
+        std::function<void(obs_sceneitem_t *, uint32_t, uint32_t)> wrapped = visitor;
+        mirror.ForEachGroup(wrapped);
+    });
+    CHECK(control > 0);
+
+    mirror.Clear();
+    FakeObs::Reset();
+    return TEST_RESULT();
+}